@@ -92,6 +92,80 @@ ReadWriteRpmb (
   return Status;
 }
 
+/**
+  Narrow a write to the bytes that differ from the in-memory copy.
+
+  The in-memory copy mirrors the RPMB contents, so bytes that already hold
+  the requested value do not need to be sent to the secure world again.
+
+  @param[in]      Instance    MEM_INSTANCE the write is targeted at
+  @param[in]      Base        In-memory copy of the range about to be written
+  @param[in]      Buffer      Data about to be written
+  @param[out]     Start       Offset of the first byte that changes
+  @param[in,out]  NumBytes    On input, the size of the write. On output, the
+                              size of the range that changes, 0 if none.
+**/
+STATIC
+VOID
+TrimUnchangedBytes (
+  IN     MEM_INSTANCE *Instance,
+  IN     CONST UINT8  *Base,
+  IN     CONST UINT8  *Buffer,
+  OUT    UINTN        *Start,
+  IN OUT UINTN        *NumBytes
+  )
+{
+  UINTN First;
+  UINTN Last;
+
+  First = 0;
+  Last = *NumBytes;
+  if (!Instance->MemStale) {
+    while ((First < Last) && (Base[First] == Buffer[First])) {
+      First++;
+    }
+    while ((Last > First) && (Base[Last - 1] == Buffer[Last - 1])) {
+      Last--;
+    }
+  }
+
+  *Start = First;
+  *NumBytes = Last - First;
+}
+
+/**
+  Check whether a block of the in-memory copy is in the erased state.
+
+  @param[in] Instance   MEM_INSTANCE describing the device
+  @param[in] Lba        Block to check
+
+  @retval TRUE          Every byte of the block is 0xFF
+  @retval FALSE         The block holds data, or the memory copy is stale
+**/
+STATIC
+BOOLEAN
+IsBlockErased (
+  IN MEM_INSTANCE *Instance,
+  IN EFI_LBA      Lba
+  )
+{
+  UINT64 *Block;
+  UINTN  Index;
+
+  if (Instance->MemStale) {
+    return FALSE;
+  }
+
+  Block = (UINT64 *)((UINTN)Instance->MemBaseAddress + (UINTN)Lba * Instance->BlockSize);
+  for (Index = 0; Index < Instance->BlockSize / sizeof (UINT64); Index++) {
+    if (Block[Index] != MAX_UINT64) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 /**
   The GetAttributes() function retrieves the attributes and
   current settings of the block.
@@ -362,6 +436,8 @@ OpTeeRpmbFvbWrite (
   MEM_INSTANCE *Instance;
   EFI_STATUS   Status;
   VOID         *Base;
+  UINTN        Start;
+  UINTN        Length;
 
   Instance = INSTANCE_FROM_FVB_THIS (This);
   if (!Instance->Initialized) {
@@ -372,13 +448,24 @@ OpTeeRpmbFvbWrite (
   }
   Base = (VOID *)(UINTN)Instance->MemBaseAddress + (Lba * Instance->BlockSize) +
          Offset;
+
+  // Variable updates mostly flip a few state bits in place, so only send
+  // the bytes that change. Each write still reaches the device before
+  // returning, which the FTW and variable drivers rely on.
+  Length = *NumBytes;
+  TrimUnchangedBytes (Instance, Base, Buffer, &Start, &Length);
+  if (Length == 0) {
+    return EFI_SUCCESS;
+  }
+
   Status = ReadWriteRpmb (
              SP_SVC_RPMB_WRITE,
-             (UINTN)Buffer,
-             *NumBytes,
-             (Lba * Instance->BlockSize) + Offset
+             (UINTN)Buffer + Start,
+             Length,
+             (Lba * Instance->BlockSize) + Offset + Start
              );
   if (EFI_ERROR (Status)) {
+    Instance->MemStale = TRUE;
     return Status;
   }
 
@@ -442,9 +529,10 @@ OpTeeRpmbFvbErase (
   )
 {
   MEM_INSTANCE *Instance;
-  UINTN   NumBytes;
   UINTN   NumLba;
+  UINTN   RunLba;
   EFI_LBA Start;
+  EFI_LBA Lba;
   VOID    *Base;
   VOID    *Buf;
   VA_LIST Args;
@@ -460,27 +548,42 @@ OpTeeRpmbFvbErase (
     if (NumLba == 0 || Start + NumLba > Instance->NBlocks) {
       return EFI_INVALID_PARAMETER;
     }
-    NumBytes = NumLba * Instance->BlockSize;
-    Base = (VOID *)(UINTN)Instance->MemBaseAddress +
-           (Start * Instance->BlockSize);
     Buf = AllocatePool (NumLba * Instance->BlockSize);
     if (Buf == NULL) {
       return EFI_DEVICE_ERROR;
     }
     SetMem64 (Buf, NumLba * Instance->BlockSize, ~0UL);
-    // Write the device
-    Status = ReadWriteRpmb (
-               SP_SVC_RPMB_WRITE,
-               (UINTN)Buf,
-               NumBytes,
-               Start * Instance->BlockSize
-               );
-    if (EFI_ERROR (Status)) {
-      FreePool (Buf);
-      return Status;
+
+    // FTW reclaim erases spare blocks that are usually already erased.
+    // Skip those and write each run of dirty blocks with a single call.
+    for (Lba = Start; Lba < Start + NumLba; Lba += RunLba) {
+      if (IsBlockErased (Instance, Lba)) {
+        RunLba = 1;
+        continue;
+      }
+      for (RunLba = 1; Lba + RunLba < Start + NumLba; RunLba++) {
+        if (IsBlockErased (Instance, Lba + RunLba)) {
+          break;
+        }
+      }
+
+      // Write the device
+      Status = ReadWriteRpmb (
+                 SP_SVC_RPMB_WRITE,
+                 (UINTN)Buf,
+                 RunLba * Instance->BlockSize,
+                 Lba * Instance->BlockSize
+                 );
+      if (EFI_ERROR (Status)) {
+        Instance->MemStale = TRUE;
+        FreePool (Buf);
+        return Status;
+      }
+      // Update the in memory copy
+      Base = (VOID *)(UINTN)Instance->MemBaseAddress +
+             (Lba * Instance->BlockSize);
+      SetMem64 (Base, RunLba * Instance->BlockSize, ~0UL);
     }
-    // Update the in memory copy
-    SetMem64 (Base, NumLba * Instance->BlockSize, ~0UL);
     FreePool (Buf);
   }
 
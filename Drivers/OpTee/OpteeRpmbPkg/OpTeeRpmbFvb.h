@@ -52,6 +52,8 @@ struct _MEM_INSTANCE
     UINT16                              BlockSize;
     /// Number of allocated blocks
     UINT16                              NBlocks;
+    /// Set when a device write failed and the memory copy may differ from it
+    BOOLEAN                             MemStale;
 };
 
 #endif
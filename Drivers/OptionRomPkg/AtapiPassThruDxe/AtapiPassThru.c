@@ -336,6 +336,8 @@ Returns:
     return Status;
   }
 
+  AtapiPassThruFreePrdTable (AtapiScsiPrivate);
+
   //
   // Restore original PCI attributes
   //
@@ -409,6 +411,14 @@ Returns:
 
   InitAtapiIoPortRegisters(AtapiScsiPrivate, IdeRegsBaseAddr);
 
+  //
+  // Set up the PRD table for bus master DMA. Failing to do so is not fatal,
+  // all transfers then use PIO.
+  //
+  if (IdeRegsBaseAddr[IdePrimary].BusMasterBaseAddr != 0) {
+    AtapiPassThruAllocatePrdTable (AtapiScsiPrivate);
+  }
+
   //
   // Initialize the LatestTargetId to MAX_TARGET_ID.
   //
@@ -416,6 +426,9 @@ Returns:
   AtapiScsiPrivate->LatestLun       = 0;
 
   Status = InstallScsiPassThruProtocols (&Controller, AtapiScsiPrivate);
+  if (EFI_ERROR (Status)) {
+    AtapiPassThruFreePrdTable (AtapiScsiPrivate);
+  }
 
   return Status;
 }
@@ -811,6 +824,11 @@ Returns:
     }
   }
 
+  //
+  // A channel reset may return the devices to their default PIO transfer mode.
+  //
+  ZeroMem (AtapiScsiPrivate->DmaSetupState, sizeof (AtapiScsiPrivate->DmaSetupState));
+
   if (ResetFlag) {
     return EFI_SUCCESS;
   }
@@ -878,6 +896,11 @@ Returns:
     AtapiScsiPrivate->IoPort = &AtapiScsiPrivate->AtapiIoPortRegisters[1];
   }
 
+  //
+  // The reset may return the device to its default PIO transfer mode.
+  //
+  AtapiScsiPrivate->DmaSetupState[ATAPI_DMA_SETUP_INDEX (AtapiScsiPrivate, Target)] = ATAPI_DMA_SETUP_PENDING;
+
   //
   // for ATAPI device, no need to wait DRDY ready after device selecting.
   //
@@ -1325,6 +1348,11 @@ Returns:
     }
   }
 
+  //
+  // A channel reset may return the devices to their default PIO transfer mode.
+  //
+  ZeroMem (AtapiScsiPrivate->DmaSetupState, sizeof (AtapiScsiPrivate->DmaSetupState));
+
   if (ResetFlag) {
     return EFI_SUCCESS;
   }
@@ -1394,6 +1422,11 @@ Returns:
     AtapiScsiPrivate->IoPort = &AtapiScsiPrivate->AtapiIoPortRegisters[1];
   }
 
+  //
+  // The reset may return the device to its default PIO transfer mode.
+  //
+  AtapiScsiPrivate->DmaSetupState[ATAPI_DMA_SETUP_INDEX (AtapiScsiPrivate, TargetId)] = ATAPI_DMA_SETUP_PENDING;
+
   //
   // for ATAPI device, no need to wait DRDY ready after device selecting.
   //
@@ -1584,6 +1617,21 @@ Returns:
     (UINT16) ((PciData.Device.Bar[3] & 0x0000fffc) + 2);
   }
 
+  //
+  // The bus master registers live in the I/O BAR4 in both modes, primary
+  // channel first.
+  //
+  IdeRegsBaseAddr[IdePrimary].BusMasterBaseAddr   = 0;
+  IdeRegsBaseAddr[IdeSecondary].BusMasterBaseAddr = 0;
+  if ((PciData.Hdr.ClassCode[0] & IDE_BUS_MASTER_CAPABLE) != 0 &&
+      (PciData.Device.Bar[4] & BIT0) != 0 &&
+      (PciData.Device.Bar[4] & 0x0000fff0) != 0) {
+    IdeRegsBaseAddr[IdePrimary].BusMasterBaseAddr   =
+    (UINT16) (PciData.Device.Bar[4] & 0x0000fff0);
+    IdeRegsBaseAddr[IdeSecondary].BusMasterBaseAddr =
+    (UINT16) ((PciData.Device.Bar[4] & 0x0000fff0) + BMIDE_CHANNEL_STRIDE);
+  }
+
   return EFI_SUCCESS;
 }
 
@@ -1638,6 +1686,8 @@ Returns:
 
     (*(UINT16 *) &RegisterPointer->Alt) = ControlBlockBaseAddr;
     RegisterPointer->DriveAddress = (UINT16) (ControlBlockBaseAddr + 0x01);
+
+    RegisterPointer->BusMasterBase = IdeRegsBaseAddr[IdeChannel].BusMasterBaseAddr;
   }
 
 }
@@ -2141,6 +2191,9 @@ Returns:
   UINT16      *CommandIndex;
   UINT8       Count;
   EFI_STATUS  Status;
+  VOID        *Mapping;
+
+  Mapping = NULL;
 
   //
   // Set all the command parameters by fill related registers.
@@ -2177,12 +2230,28 @@ Returns:
   }
 
   //
-  // No OVL; No DMA (by setting feature register)
+  // Use bus master DMA when the command and buffer allow it, PIO otherwise.
+  //
+  Status = AtapiPassThruDmaPrepare (
+             AtapiScsiPrivate,
+             Target,
+             PacketCommand,
+             Buffer,
+             *ByteCount,
+             Direction,
+             &Mapping
+             );
+  if (EFI_ERROR (Status)) {
+    Mapping = NULL;
+  }
+
+  //
+  // No OVL; DMA only if the bus master is armed (by setting feature register)
   //
   WritePortB (
     AtapiScsiPrivate->PciIo,
     AtapiScsiPrivate->IoPort->Reg1.Feature,
-    0x00
+    (UINT8) ((Mapping != NULL) ? DMA : 0x00)
     );
 
   //
@@ -2202,12 +2271,13 @@ Returns:
 
   //
   //  DEFAULT_CTL:0x0a (0000,1010)
-  //  Disable interrupt
+  //  Disable interrupt. A DMA transfer needs INTRQ enabled, as completion
+  //  is signalled through the interrupt bit of the bus master status.
   //
   WritePortB (
     AtapiScsiPrivate->PciIo,
     AtapiScsiPrivate->IoPort->Alt.DeviceControl,
-    DEFAULT_CTL
+    (UINT8) ((Mapping != NULL) ? (DEFAULT_CTL & ~IEN_L) : DEFAULT_CTL)
     );
 
   //
@@ -2231,6 +2301,15 @@ Returns:
       Status = EFI_DEVICE_ERROR;
     }
 
+    if (Mapping != NULL) {
+      WritePortB (
+        AtapiScsiPrivate->PciIo,
+        AtapiScsiPrivate->IoPort->Alt.DeviceControl,
+        DEFAULT_CTL
+        );
+      AtapiScsiPrivate->PciIo->Unmap (AtapiScsiPrivate->PciIo, Mapping);
+    }
+
     *ByteCount = 0;
     return Status;
   }
@@ -2243,6 +2322,19 @@ Returns:
     WritePortW (AtapiScsiPrivate->PciIo, AtapiScsiPrivate->IoPort->Data, *CommandIndex);
   }
 
+  if (Mapping != NULL) {
+    Status = AtapiPassThruDmaReadWriteData (
+               AtapiScsiPrivate,
+               Mapping,
+               TimeoutInMicroSeconds
+               );
+    if (EFI_ERROR (Status)) {
+      *ByteCount = 0;
+    }
+
+    return Status;
+  }
+
   //
   // call AtapiPassThruPioReadWriteData() function to get
   // requested transfer data form device.
@@ -2382,6 +2474,521 @@ Arguments:
   return Status;
 }
 
+VOID
+AtapiPassThruAllocatePrdTable (
+  ATAPI_SCSI_PASS_THRU_DEV    *AtapiScsiPrivate
+  )
+/*++
+
+Routine Description:
+
+  Allocate and map the PRD table used for bus master DMA. On failure the
+  PrdTable field stays NULL and all transfers use PIO.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure of the controller.
+
+Returns:
+
+  None
+
+--*/
+{
+  EFI_STATUS          Status;
+  EFI_PCI_IO_PROTOCOL *PciIo;
+  VOID                *Buffer;
+  UINTN               Bytes;
+
+  PciIo = AtapiScsiPrivate->PciIo;
+
+  Status = PciIo->AllocateBuffer (
+                    PciIo,
+                    AllocateAnyPages,
+                    EfiBootServicesData,
+                    ATAPI_PRD_TABLE_PAGES,
+                    &Buffer,
+                    0
+                    );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  Bytes = EFI_PAGES_TO_SIZE (ATAPI_PRD_TABLE_PAGES);
+  Status = PciIo->Map (
+                    PciIo,
+                    EfiPciIoOperationBusMasterCommonBuffer,
+                    Buffer,
+                    &Bytes,
+                    &AtapiScsiPrivate->PrdTableDeviceAddr,
+                    &AtapiScsiPrivate->PrdTableMapping
+                    );
+  if (EFI_ERROR (Status) ||
+      Bytes != EFI_PAGES_TO_SIZE (ATAPI_PRD_TABLE_PAGES) ||
+      AtapiScsiPrivate->PrdTableDeviceAddr + Bytes > SIZE_4GB) {
+    if (!EFI_ERROR (Status)) {
+      PciIo->Unmap (PciIo, AtapiScsiPrivate->PrdTableMapping);
+    }
+    PciIo->FreeBuffer (PciIo, ATAPI_PRD_TABLE_PAGES, Buffer);
+    return;
+  }
+
+  AtapiScsiPrivate->PrdTable = Buffer;
+}
+
+VOID
+AtapiPassThruFreePrdTable (
+  ATAPI_SCSI_PASS_THRU_DEV    *AtapiScsiPrivate
+  )
+/*++
+
+Routine Description:
+
+  Unmap and free the PRD table, if any.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure of the controller.
+
+Returns:
+
+  None
+
+--*/
+{
+  EFI_PCI_IO_PROTOCOL *PciIo;
+
+  if (AtapiScsiPrivate->PrdTable == NULL) {
+    return;
+  }
+
+  PciIo = AtapiScsiPrivate->PciIo;
+  PciIo->Unmap (PciIo, AtapiScsiPrivate->PrdTableMapping);
+  PciIo->FreeBuffer (PciIo, ATAPI_PRD_TABLE_PAGES, AtapiScsiPrivate->PrdTable);
+  AtapiScsiPrivate->PrdTable = NULL;
+}
+
+EFI_STATUS
+AtapiPassThruDmaSetup (
+  ATAPI_SCSI_PASS_THRU_DEV    *AtapiScsiPrivate,
+  UINT32                      Target
+  )
+/*++
+
+Routine Description:
+
+  Put an ATAPI device into a DMA transfer mode and mark it DMA capable in
+  the bus master status register. The device must be selected on the
+  channel that IoPort points to.
+
+  The highest Ultra DMA mode the device reports is used, or the highest
+  Multiword DMA mode if it has no Ultra DMA support. Programming matching
+  timings into the IDE controller is chipset specific and left to the
+  platform, see PcdAtapiPassThruBusMasterDma.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure for the specified channel.
+  Target:             The Target ID of the ATAPI device on the channel.
+
+Returns:
+
+  EFI_SUCCESS       - The device is ready for DMA transfers.
+  EFI_UNSUPPORTED   - The device does not support DMA.
+  EFI_DEVICE_ERROR  - A command failed.
+  EFI_TIMEOUT       - A command did not complete in time.
+
+--*/
+{
+  EFI_STATUS          Status;
+  EFI_PCI_IO_PROTOCOL *PciIo;
+  UINT16              IdentifyData[ATAPI_IDENTIFY_WORDS];
+  UINT16              BusMasterBase;
+  UINT8               BusMasterStatus;
+  UINT8               TransferMode;
+  UINTN               Index;
+
+  PciIo         = AtapiScsiPrivate->PciIo;
+  BusMasterBase = AtapiScsiPrivate->IoPort->BusMasterBase;
+
+  //
+  // Issue IDENTIFY PACKET DEVICE with interrupts disabled and read the
+  // 256 words of identify data by PIO.
+  //
+  WritePortB (PciIo, AtapiScsiPrivate->IoPort->Alt.DeviceControl, DEFAULT_CTL);
+  WritePortB (PciIo, AtapiScsiPrivate->IoPort->Head, (UINT8) ((Target << 4) | DEFAULT_CMD));
+
+  Status = StatusDRQClear (AtapiScsiPrivate, ATAPI_DMA_SETUP_TIMEOUT);
+  if (EFI_ERROR (Status)) {
+    return (Status == EFI_ABORTED) ? EFI_DEVICE_ERROR : Status;
+  }
+
+  WritePortB (PciIo, AtapiScsiPrivate->IoPort->Reg.Command, ATAPI_IDENTIFY_DEVICE_CMD);
+
+  Status = StatusDRQReady (AtapiScsiPrivate, ATAPI_DMA_SETUP_TIMEOUT);
+  if (EFI_ERROR (Status)) {
+    return (Status == EFI_ABORTED) ? EFI_DEVICE_ERROR : Status;
+  }
+
+  for (Index = 0; Index < ATAPI_IDENTIFY_WORDS; Index++) {
+    IdentifyData[Index] = ReadPortW (PciIo, AtapiScsiPrivate->IoPort->Data);
+  }
+
+  Status = StatusWaitForBSYClear (AtapiScsiPrivate, ATAPI_DMA_SETUP_TIMEOUT);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if ((IdentifyData[ATAPI_IDENTIFY_CAPABILITIES] & ATAPI_IDENTIFY_DMA_SUPPORTED) == 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Pick the fastest mode the device supports.
+  //
+  TransferMode = 0;
+  if ((IdentifyData[ATAPI_IDENTIFY_FIELD_VALIDITY] & ATAPI_IDENTIFY_WORD88_VALID) != 0) {
+    for (Index = ATAPI_MAX_UDMA_MODE; Index > 0; Index--) {
+      if ((IdentifyData[ATAPI_IDENTIFY_UDMA_MODES] & (1 << (Index - 1))) != 0) {
+        TransferMode = (UINT8) (ATA_TRANSFER_MODE_UDMA | (Index - 1));
+        break;
+      }
+    }
+  }
+
+  if (TransferMode == 0) {
+    for (Index = ATAPI_MAX_MWDMA_MODE; Index > 0; Index--) {
+      if ((IdentifyData[ATAPI_IDENTIFY_MWDMA_MODES] & (1 << (Index - 1))) != 0) {
+        TransferMode = (UINT8) (ATA_TRANSFER_MODE_MWDMA | (Index - 1));
+        break;
+      }
+    }
+  }
+
+  if (TransferMode == 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // SET FEATURES - Set Transfer Mode
+  //
+  Status = StatusDRQClear (AtapiScsiPrivate, ATAPI_DMA_SETUP_TIMEOUT);
+  if (EFI_ERROR (Status)) {
+    return (Status == EFI_ABORTED) ? EFI_DEVICE_ERROR : Status;
+  }
+
+  WritePortB (PciIo, AtapiScsiPrivate->IoPort->Reg1.Feature, ATA_SUB_CMD_SET_TRANSFER_MODE);
+  WritePortB (PciIo, AtapiScsiPrivate->IoPort->SectorCount, TransferMode);
+  WritePortB (PciIo, AtapiScsiPrivate->IoPort->Reg.Command, ATA_SET_FEATURES_CMD);
+
+  Status = StatusWaitForBSYClear (AtapiScsiPrivate, ATAPI_DMA_SETUP_TIMEOUT);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if ((ReadPortB (PciIo, AtapiScsiPrivate->IoPort->Reg.Status) & ERR) != 0) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  //
+  // Mark the drive DMA capable. Interrupt and Error are write-one-to-clear,
+  // so leave them alone.
+  //
+  BusMasterStatus = ReadPortB (PciIo, (UINT16) (BusMasterBase + BMIDE_REG_STATUS));
+  BusMasterStatus &= (UINT8) ~(BMIS_INTERRUPT | BMIS_ERROR);
+  BusMasterStatus |= (UINT8) ((Target == 0) ? BMIS_DRIVE0_DMA_CAPABLE : BMIS_DRIVE1_DMA_CAPABLE);
+  WritePortB (PciIo, (UINT16) (BusMasterBase + BMIDE_REG_STATUS), BusMasterStatus);
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+AtapiPassThruDmaPrepare (
+  ATAPI_SCSI_PASS_THRU_DEV    *AtapiScsiPrivate,
+  UINT32                      Target,
+  UINT8                       *PacketCommand,
+  VOID                        *Buffer,
+  UINT32                      ByteCount,
+  DATA_DIRECTION              Direction,
+  VOID                        **Mapping
+  )
+/*++
+
+Routine Description:
+
+  Check whether a packet command can move its data by bus master DMA and,
+  if so, map the buffer, build the PRD table and arm the bus master.
+
+  Only commands whose transfer length is fixed by the CDB are eligible, as
+  a DMA transfer cannot report a short count. The drive must also be marked
+  DMA capable in the bus master status register. Platform code sets this
+  bit after it programs the controller's DMA timings. When
+  PcdAtapiPassThruBusMasterDma is TRUE this driver sets the bit itself
+  through AtapiPassThruDmaSetup() on first use of each device.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure for the specified channel.
+  Target:             The Target ID of the ATAPI device.
+  PacketCommand:      Points to the ATAPI command packet.
+  Buffer:             Points to the transferred data.
+  ByteCount:          The size of the transfer in bytes.
+  Direction:          Indicates the data transfer direction.
+  Mapping:            Receives the mapping of Buffer.
+
+Returns:
+
+  EFI_SUCCESS       - The bus master is armed for the transfer.
+  EFI_UNSUPPORTED   - The command must use PIO.
+
+--*/
+{
+  EFI_STATUS                    Status;
+  EFI_PCI_IO_PROTOCOL           *PciIo;
+  EFI_PCI_IO_PROTOCOL_OPERATION Operation;
+  EFI_PHYSICAL_ADDRESS          DeviceAddress;
+  UINTN                         MappedLength;
+  UINTN                         Index;
+  UINT32                        Remaining;
+  UINT32                        Length;
+  UINT32                        PrdTableAddr;
+  UINT16                        BusMasterBase;
+  UINT8                         BusMasterStatus;
+  ATAPI_PRD                     *PrdTable;
+  UINTN                         SetupIndex;
+
+  PciIo         = AtapiScsiPrivate->PciIo;
+  PrdTable      = AtapiScsiPrivate->PrdTable;
+  BusMasterBase = AtapiScsiPrivate->IoPort->BusMasterBase;
+
+  if (PrdTable == NULL || BusMasterBase == 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (Buffer == NULL || ByteCount == 0 || (ByteCount & 1) != 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  switch (PacketCommand[0]) {
+  case OP_READ_10:
+  case OP_READ_12:
+  case OP_WRITE_10:
+  case OP_WRITE_12:
+    break;
+
+  default:
+    return EFI_UNSUPPORTED;
+  }
+
+  if ((Direction != DataIn) && (Direction != DataOut)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (PcdGetBool (PcdAtapiPassThruBusMasterDma)) {
+    SetupIndex = ATAPI_DMA_SETUP_INDEX (AtapiScsiPrivate, Target);
+    if (AtapiScsiPrivate->DmaSetupState[SetupIndex] == ATAPI_DMA_SETUP_PENDING) {
+      Status = AtapiPassThruDmaSetup (AtapiScsiPrivate, Target);
+      DEBUG ((
+        DEBUG_INFO,
+        "AtapiPassThru: bus master DMA setup for device %d: %r\n",
+        (UINT32) SetupIndex,
+        Status
+        ));
+      AtapiScsiPrivate->DmaSetupState[SetupIndex] = (UINT8) (EFI_ERROR (Status) ? ATAPI_DMA_SETUP_FAILED : ATAPI_DMA_SETUP_DONE);
+    }
+  }
+
+  BusMasterStatus = ReadPortB (PciIo, (UINT16) (BusMasterBase + BMIDE_REG_STATUS));
+  if ((BusMasterStatus & ((Target == 0) ? BMIS_DRIVE0_DMA_CAPABLE : BMIS_DRIVE1_DMA_CAPABLE)) == 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  MappedLength = ByteCount;
+  Status = PciIo->Map (
+                    PciIo,
+                    (Direction == DataIn) ? EfiPciIoOperationBusMasterWrite : EfiPciIoOperationBusMasterRead,
+                    Buffer,
+                    &MappedLength,
+                    &DeviceAddress,
+                    Mapping
+                    );
+  if (EFI_ERROR (Status)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (MappedLength != ByteCount ||
+      (DeviceAddress & 1) != 0 ||
+      DeviceAddress + ByteCount > SIZE_4GB) {
+    PciIo->Unmap (PciIo, *Mapping);
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Split the buffer at 64KB boundaries, one PRD per region.
+  //
+  Index     = 0;
+  Remaining = ByteCount;
+  while (Remaining > 0) {
+    if (Index == ATAPI_PRD_MAX_ENTRIES) {
+      PciIo->Unmap (PciIo, *Mapping);
+      return EFI_UNSUPPORTED;
+    }
+
+    Length = (UINT32) (ATAPI_PRD_MAX_BYTES - (DeviceAddress & (ATAPI_PRD_MAX_BYTES - 1)));
+    Length = MIN (Length, Remaining);
+
+    PrdTable[Index].RegionBaseAddr  = (UINT32) DeviceAddress;
+    PrdTable[Index].ByteCount       = (UINT16) Length;
+    PrdTable[Index].EndOfTable      = 0;
+
+    DeviceAddress += Length;
+    Remaining     -= Length;
+    Index++;
+  }
+  PrdTable[Index - 1].EndOfTable = ATAPI_PRD_EOT;
+
+  //
+  // Stop the engine, clear stale interrupt and error bits while keeping the
+  // drive DMA capable bits, then load the table and set the direction.
+  //
+  WritePortB (PciIo, (UINT16) (BusMasterBase + BMIDE_REG_COMMAND), 0);
+  WritePortB (
+    PciIo,
+    (UINT16) (BusMasterBase + BMIDE_REG_STATUS),
+    (UINT8) (BusMasterStatus | BMIS_INTERRUPT | BMIS_ERROR)
+    );
+
+  PrdTableAddr = (UINT32) AtapiScsiPrivate->PrdTableDeviceAddr;
+  PciIo->Io.Write (
+              PciIo,
+              EfiPciIoWidthUint32,
+              EFI_PCI_IO_PASS_THROUGH_BAR,
+              (UINT64) (BusMasterBase + BMIDE_REG_PRD_TABLE),
+              1,
+              &PrdTableAddr
+              );
+
+  WritePortB (
+    PciIo,
+    (UINT16) (BusMasterBase + BMIDE_REG_COMMAND),
+    (UINT8) ((Direction == DataIn) ? BMIC_READ_FROM_DEVICE : 0)
+    );
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+AtapiPassThruDmaReadWriteData (
+  ATAPI_SCSI_PASS_THRU_DEV    *AtapiScsiPrivate,
+  VOID                        *Mapping,
+  UINT64                      TimeoutInMicroSeconds
+  )
+/*++
+
+Routine Description:
+
+  Start the armed bus master after the command packet is sent and wait for
+  the transfer to complete.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure for the specified channel.
+  Mapping:            The mapping returned by AtapiPassThruDmaPrepare.
+  TimeoutInMicroSeconds:
+                      The timeout, in micro second units, to use for the
+                      execution of this ATAPI command.
+                      A TimeoutInMicroSeconds value of 0 means that
+                      this function will wait indefinitely.
+
+Returns:
+
+  EFI_STATUS
+
+--*/
+{
+  EFI_STATUS          Status;
+  EFI_PCI_IO_PROTOCOL *PciIo;
+  UINT16              BusMasterBase;
+  UINT8               BusMasterCommand;
+  UINT8               BusMasterStatus;
+  UINT64              Delay;
+
+  PciIo         = AtapiScsiPrivate->PciIo;
+  BusMasterBase = AtapiScsiPrivate->IoPort->BusMasterBase;
+
+  BusMasterCommand = ReadPortB (PciIo, (UINT16) (BusMasterBase + BMIDE_REG_COMMAND));
+  WritePortB (
+    PciIo,
+    (UINT16) (BusMasterBase + BMIDE_REG_COMMAND),
+    (UINT8) (BusMasterCommand | BMIC_START)
+    );
+
+  if (TimeoutInMicroSeconds == 0) {
+    Delay = 2;
+  } else {
+    Delay = DivU64x32 (TimeoutInMicroSeconds, (UINT32) 30) + 1;
+  }
+
+  do {
+
+    BusMasterStatus = ReadPortB (PciIo, (UINT16) (BusMasterBase + BMIDE_REG_STATUS));
+    if ((BusMasterStatus & (BMIS_INTERRUPT | BMIS_ERROR)) != 0) {
+      break;
+    }
+
+    //
+    // Stall for 30 us
+    //
+    gBS->Stall (30);
+
+    //
+    // Loop infinitely if not meeting expected condition
+    //
+    if (TimeoutInMicroSeconds == 0) {
+      Delay = 2;
+    }
+
+    Delay--;
+  } while (Delay);
+
+  //
+  // Stop the engine and acknowledge the interrupt and error bits.
+  //
+  WritePortB (
+    PciIo,
+    (UINT16) (BusMasterBase + BMIDE_REG_COMMAND),
+    (UINT8) (BusMasterCommand & ~BMIC_START)
+    );
+  WritePortB (
+    PciIo,
+    (UINT16) (BusMasterBase + BMIDE_REG_STATUS),
+    (UINT8) (ReadPortB (PciIo, (UINT16) (BusMasterBase + BMIDE_REG_STATUS)) | BMIS_INTERRUPT | BMIS_ERROR)
+    );
+
+  if (Delay == 0) {
+    Status = EFI_TIMEOUT;
+  } else if ((BusMasterStatus & BMIS_ERROR) != 0) {
+    Status = EFI_DEVICE_ERROR;
+  } else {
+    //
+    // Reading the status register also clears the device's INTRQ.
+    //
+    Status = StatusWaitForBSYClear (AtapiScsiPrivate, TimeoutInMicroSeconds);
+    if (!EFI_ERROR (Status)) {
+      Status = AtapiPassThruCheckErrorStatus (AtapiScsiPrivate);
+    }
+  }
+
+  WritePortB (
+    PciIo,
+    AtapiScsiPrivate->IoPort->Alt.DeviceControl,
+    DEFAULT_CTL
+    );
+  PciIo->Unmap (PciIo, Mapping);
+
+  return Status;
+}
+
 
 UINT8
 ReadPortB (
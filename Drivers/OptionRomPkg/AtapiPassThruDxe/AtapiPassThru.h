@@ -67,10 +67,58 @@ typedef enum {
 #define IDE_PRIMARY_PROGRAMMABLE_INDICATOR    BIT1
 #define IDE_SECONDARY_OPERATING_MODE          BIT2
 #define IDE_SECONDARY_PROGRAMMABLE_INDICATOR  BIT3
+#define IDE_BUS_MASTER_CAPABLE                BIT7
+
+//
+// PCI IDE bus master (BMIDE) registers, relative to the channel's base in BAR4
+//
+#define BMIDE_REG_COMMAND     0x00
+#define BMIDE_REG_STATUS      0x02
+#define BMIDE_REG_PRD_TABLE   0x04
+#define BMIDE_CHANNEL_STRIDE  0x08
+
+#define BMIC_START            BIT0
+#define BMIC_READ_FROM_DEVICE BIT3  ///< Bus master writes to host memory
+
+#define BMIS_ACTIVE           BIT0
+#define BMIS_ERROR            BIT1
+#define BMIS_INTERRUPT        BIT2
+#define BMIS_DRIVE0_DMA_CAPABLE BIT5
+#define BMIS_DRIVE1_DMA_CAPABLE BIT6
+
+///
+/// Physical Region Descriptor. A region must not cross a 64KB boundary and a
+/// ByteCount of 0 stands for 64KB.
+///
+#pragma pack(1)
+typedef struct {
+  UINT32  RegionBaseAddr;
+  UINT16  ByteCount;
+  UINT16  EndOfTable;
+} ATAPI_PRD;
+#pragma pack()
+
+#define ATAPI_PRD_EOT           BIT15
+#define ATAPI_PRD_MAX_BYTES     0x10000
+#define ATAPI_PRD_TABLE_PAGES   1
+#define ATAPI_PRD_MAX_ENTRIES   (EFI_PAGES_TO_SIZE (ATAPI_PRD_TABLE_PAGES) / sizeof (ATAPI_PRD))
 
 
 #define ATAPI_MAX_CHANNEL 2
 
+//
+// Per device state of the bus master DMA setup
+//
+#define ATAPI_DMA_SETUP_PENDING 0
+#define ATAPI_DMA_SETUP_DONE    1
+#define ATAPI_DMA_SETUP_FAILED  2
+
+//
+// Index into DmaSetupState for a device on the channel IoPort points to
+//
+#define ATAPI_DMA_SETUP_INDEX(Private, Device) \
+  ((((Private)->IoPort == &(Private)->AtapiIoPortRegisters[0]) ? 0 : 2) + ((Device) % 2))
+
 ///
 /// IDE registers set
 ///
@@ -85,6 +133,7 @@ typedef struct {
   IDE_CMD_OR_STATUS               Reg;
   IDE_AltStatus_OR_DeviceControl  Alt;
   UINT16                          DriveAddress;
+  UINT16                          BusMasterBase;  ///< 0 if the channel has no BMIDE registers
 } IDE_BASE_REGISTERS;
 
 #define ATAPI_SCSI_PASS_THRU_DEV_SIGNATURE  SIGNATURE_32 ('a', 's', 'p', 't')
@@ -103,6 +152,16 @@ typedef struct {
   IDE_BASE_REGISTERS               AtapiIoPortRegisters[2];
   UINT32                           LatestTargetId;
   UINT64                           LatestLun;
+  //
+  // PRD table shared by both channels, NULL if bus master DMA is not used
+  //
+  ATAPI_PRD                        *PrdTable;
+  EFI_PHYSICAL_ADDRESS             PrdTableDeviceAddr;
+  VOID                             *PrdTableMapping;
+  //
+  // ATAPI_DMA_SETUP_* per Target ID, used with PcdAtapiPassThruBusMasterDma
+  //
+  UINT8                            DmaSetupState[MAX_TARGET_ID];
 } ATAPI_SCSI_PASS_THRU_DEV;
 
 //
@@ -111,6 +170,7 @@ typedef struct {
 typedef struct {
   UINT16  CommandBlockBaseAddr;
   UINT16  ControlBlockBaseAddr;
+  UINT16  BusMasterBaseAddr;
 } IDE_REGISTERS_BASE_ADDR;
 
 #define ATAPI_SCSI_PASS_THRU_DEV_FROM_THIS(a) \
@@ -175,7 +235,35 @@ extern EFI_DRIVER_SUPPORTED_EFI_VERSION_PROTOCOL  gAtapiScsiPassThruDriverSuppor
 //
 // ATA Command
 //
-#define ATAPI_SOFT_RESET_CMD  0x08
+#define ATAPI_SOFT_RESET_CMD      0x08
+#define ATAPI_IDENTIFY_DEVICE_CMD 0xA1
+#define ATA_SET_FEATURES_CMD      0xEF
+
+//
+// SET FEATURES subcommand and transfer mode values
+//
+#define ATA_SUB_CMD_SET_TRANSFER_MODE 0x03
+#define ATA_TRANSFER_MODE_MWDMA       0x20
+#define ATA_TRANSFER_MODE_UDMA        0x40
+
+//
+// IDENTIFY PACKET DEVICE data, word offsets and bits
+//
+#define ATAPI_IDENTIFY_WORDS              256
+#define ATAPI_IDENTIFY_CAPABILITIES       49
+#define ATAPI_IDENTIFY_DMA_SUPPORTED      BIT8
+#define ATAPI_IDENTIFY_FIELD_VALIDITY     53
+#define ATAPI_IDENTIFY_WORD88_VALID       BIT2
+#define ATAPI_IDENTIFY_MWDMA_MODES        63
+#define ATAPI_IDENTIFY_UDMA_MODES         88
+
+#define ATAPI_MAX_MWDMA_MODE              3
+#define ATAPI_MAX_UDMA_MODE               7
+
+//
+// Time allowed for each step of the DMA setup commands
+//
+#define ATAPI_DMA_SETUP_TIMEOUT           (3 * 1000 * 1000)
 
 typedef enum {
   DataIn  = 0,
@@ -1175,6 +1263,142 @@ Returns:
 --*/
 ;
 
+VOID
+AtapiPassThruAllocatePrdTable (
+  ATAPI_SCSI_PASS_THRU_DEV    *AtapiScsiPrivate
+  )
+/*++
+
+Routine Description:
+
+  Allocate and map the PRD table used for bus master DMA. On failure the
+  PrdTable field stays NULL and all transfers use PIO.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure of the controller.
+
+Returns:
+
+  None
+
+--*/
+;
+
+VOID
+AtapiPassThruFreePrdTable (
+  ATAPI_SCSI_PASS_THRU_DEV    *AtapiScsiPrivate
+  )
+/*++
+
+Routine Description:
+
+  Unmap and free the PRD table, if any.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure of the controller.
+
+Returns:
+
+  None
+
+--*/
+;
+
+EFI_STATUS
+AtapiPassThruDmaSetup (
+  ATAPI_SCSI_PASS_THRU_DEV    *AtapiScsiPrivate,
+  UINT32                      Target
+  )
+/*++
+
+Routine Description:
+
+  Put an ATAPI device into a DMA transfer mode and mark it DMA capable in
+  the bus master status register. The device must be selected on the
+  channel that IoPort points to.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure for the specified channel.
+  Target:             The Target ID of the ATAPI device on the channel.
+
+Returns:
+
+  EFI_SUCCESS       - The device is ready for DMA transfers.
+  EFI_UNSUPPORTED   - The device does not support DMA.
+  EFI_DEVICE_ERROR  - A command failed.
+  EFI_TIMEOUT       - A command did not complete in time.
+
+--*/
+;
+
+EFI_STATUS
+AtapiPassThruDmaPrepare (
+  ATAPI_SCSI_PASS_THRU_DEV    *AtapiScsiPrivate,
+  UINT32                      Target,
+  UINT8                       *PacketCommand,
+  VOID                        *Buffer,
+  UINT32                      ByteCount,
+  DATA_DIRECTION              Direction,
+  VOID                        **Mapping
+  )
+/*++
+
+Routine Description:
+
+  Check whether a packet command can move its data by bus master DMA and,
+  if so, map the buffer, build the PRD table and arm the bus master.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure for the specified channel.
+  Target:             The Target ID of the ATAPI device.
+  PacketCommand:      Points to the ATAPI command packet.
+  Buffer:             Points to the transferred data.
+  ByteCount:          The size of the transfer in bytes.
+  Direction:          Indicates the data transfer direction.
+  Mapping:            Receives the mapping of Buffer.
+
+Returns:
+
+  EFI_SUCCESS       - The bus master is armed for the transfer.
+  EFI_UNSUPPORTED   - The command must use PIO.
+
+--*/
+;
+
+EFI_STATUS
+AtapiPassThruDmaReadWriteData (
+  ATAPI_SCSI_PASS_THRU_DEV    *AtapiScsiPrivate,
+  VOID                        *Mapping,
+  UINT64                      TimeoutInMicroSeconds
+  )
+/*++
+
+Routine Description:
+
+  Start the armed bus master after the command packet is sent and wait for
+  the transfer to complete.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure for the specified channel.
+  Mapping:            The mapping returned by AtapiPassThruDmaPrepare.
+  TimeoutInMicroSeconds:
+                      The timeout, in micro second units, to use for the
+                      execution of this ATAPI command.
+                      A TimeoutInMicroSeconds value of 0 means that
+                      this function will wait indefinitely.
+
+Returns:
+
+  EFI_STATUS
+
+--*/
+;
+
 
 UINT8
 ReadPortB (
@@ -93,6 +93,12 @@ typedef struct {
   UINTN                                 MaxMode;
   CIRRUS_LOGIC_5430_MODE_DATA           ModeData[CIRRUS_LOGIC_5430_MODE_COUNT];
   UINT8                                 *LineBuffer;
+  //
+  // Frame sized staging area for BufferToVideo, so that a full-width
+  // rectangle reaches VRAM in one PCI I/O write. It is never read back;
+  // VRAM may be changed behind the driver's back.
+  //
+  UINT8                                 *StagingBuffer;
   BOOLEAN                               HardwareNeedsStarting;
 } CIRRUS_LOGIC_5430_PRIVATE_DATA;
 
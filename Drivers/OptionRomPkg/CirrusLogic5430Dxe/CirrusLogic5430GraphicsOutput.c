@@ -162,6 +162,17 @@ Routine Description:
     return EFI_OUT_OF_RESOURCES;
   }
 
+  if (Private->StagingBuffer) {
+    gBS->FreePool (Private->StagingBuffer);
+  }
+
+  Private->StagingBuffer = AllocatePool (
+                             ModeData->HorizontalResolution * ModeData->VerticalResolution
+                             );
+  if (Private->StagingBuffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
   InitializeGraphicsMode (Private, &CirrusLogic5430VideoModes[ModeData->ModeNumber]);
 
   This->Mode->Mode = ModeNumber;
@@ -176,6 +187,151 @@ Routine Description:
   return EFI_SUCCESS;
 }
 
+/**
+  Move a rectangle within VRAM using the GD5430 BitBLT engine.
+
+  Overlapping moves towards higher addresses are run backwards so the source
+  is not overwritten before it has been read.
+
+  @param  Private       Pointer to the private data of the device.
+  @param  SourceOffset  VRAM offset of the top left pixel of the source.
+  @param  Offset        VRAM offset of the top left pixel of the destination.
+  @param  Width         Width of the rectangle in pixels.
+  @param  Height        Height of the rectangle in pixels.
+  @param  ScreenWidth   Pitch of the frame buffer in pixels.
+
+**/
+STATIC
+VOID
+CirrusLogic5430BitBlt (
+  IN CIRRUS_LOGIC_5430_PRIVATE_DATA  *Private,
+  IN UINTN                           SourceOffset,
+  IN UINTN                           Offset,
+  IN UINTN                           Width,
+  IN UINTN                           Height,
+  IN UINTN                           ScreenWidth
+  )
+{
+  UINT16  Mode;
+
+  Mode = 0x0030;
+  if (Offset > SourceOffset) {
+    //
+    // Decrementing addresses start from the bottom right pixel.
+    //
+    Mode          |= 0x0100;
+    SourceOffset  += (Height - 1) * ScreenWidth + Width - 1;
+    Offset        += (Height - 1) * ScreenWidth + Width - 1;
+  }
+
+  //
+  // The width and height registers hold the extent minus one.
+  //
+  Width--;
+  Height--;
+
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0000);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0010);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0012);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0014);
+
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0001);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0011);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0013);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0015);
+
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((Width << 8) & 0xff00) | 0x20));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((Width & 0xff00) | 0x21));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((Height << 8) & 0xff00) | 0x22));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((Height & 0xff00) | 0x23));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((ScreenWidth << 8) & 0xff00) | 0x24));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((ScreenWidth & 0xff00) | 0x25));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((ScreenWidth << 8) & 0xff00) | 0x26));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((ScreenWidth & 0xff00) | 0x27));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((Offset) << 8) & 0xff00) | 0x28));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((Offset) >> 0) & 0xff00) | 0x29));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((Offset) >> 8) & 0xff00) | 0x2a));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((SourceOffset) << 8) & 0xff00) | 0x2c));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((SourceOffset) >> 0) & 0xff00) | 0x2d));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((SourceOffset) >> 8) & 0xff00) | 0x2e));
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x002f);
+  outw (Private, GRAPH_ADDRESS_REGISTER, Mode);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0d32);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0033);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0034);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0035);
+
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0231);
+
+  outb (Private, GRAPH_ADDRESS_REGISTER, 0x31);
+  while ((inb (Private, GRAPH_DATA_REGISTER) & 0x01) == 0x01)
+    ;
+}
+
+/**
+  Copy a rectangle of the staging buffer to VRAM.
+
+  A rectangle spanning the full width of the screen is contiguous in VRAM and
+  is written with a single PCI I/O request; otherwise each row is written on
+  its own. Only the rectangle itself is written, as the staging buffer holds
+  no valid data outside of it.
+
+  @param  Private   Pointer to the private data of the device.
+  @param  X         X coordinate of the top left pixel of the rectangle.
+  @param  Y         Y coordinate of the top left pixel of the rectangle.
+  @param  Width     Width of the rectangle in pixels.
+  @param  Height    Height of the rectangle in pixels.
+
+**/
+STATIC
+VOID
+CirrusLogic5430FlushStaging (
+  IN CIRRUS_LOGIC_5430_PRIVATE_DATA  *Private,
+  IN UINTN                           X,
+  IN UINTN                           Y,
+  IN UINTN                           Width,
+  IN UINTN                           Height
+  )
+{
+  UINTN  ScreenWidth;
+  UINTN  Offset;
+  UINTN  Length;
+  UINTN  Rows;
+  UINTN  Row;
+
+  ScreenWidth = Private->ModeData[Private->GraphicsOutput.Mode->Mode].HorizontalResolution;
+  Length      = Width;
+  Rows        = Height;
+
+  if (X == 0 && Width == ScreenWidth) {
+    Length = ScreenWidth * Height;
+    Rows   = 1;
+  }
+
+  for (Row = 0; Row < Rows; Row++) {
+    Offset = (Y + Row) * ScreenWidth + X;
+    if (((Offset & 0x03) == 0) && ((Length & 0x03) == 0)) {
+      Private->PciIo->Mem.Write (
+                            Private->PciIo,
+                            EfiPciIoWidthUint32,
+                            0,
+                            Offset,
+                            Length >> 2,
+                            Private->StagingBuffer + Offset
+                            );
+    } else {
+      Private->PciIo->Mem.Write (
+                            Private->PciIo,
+                            EfiPciIoWidthUint8,
+                            0,
+                            Offset,
+                            Length,
+                            Private->StagingBuffer + Offset
+                            );
+    }
+  }
+}
+
 EFI_STATUS
 EFIAPI
 CirrusLogic5430GraphicsOutputBlt (
@@ -231,6 +387,7 @@ Returns:
   UINTN                           Offset;
   UINTN                           SourceOffset;
   UINT32                          CurrentMode;
+  UINT8                           *Staging;
 
   Private = CIRRUS_LOGIC_5430_PRIVATE_DATA_FROM_GRAPHICS_OUTPUT_THIS (This);
 
@@ -284,6 +441,16 @@ Returns:
     if (DestinationX + Width > Private->ModeData[CurrentMode].HorizontalResolution) {
       return EFI_INVALID_PARAMETER;
     }
+
+    if (BltOperation == EfiBltVideoToVideo) {
+      if (SourceY + Height > Private->ModeData[CurrentMode].VerticalResolution) {
+        return EFI_INVALID_PARAMETER;
+      }
+
+      if (SourceX + Width > Private->ModeData[CurrentMode].HorizontalResolution) {
+        return EFI_INVALID_PARAMETER;
+      }
+    }
   }
   //
   // We have to raise to TPL Notify, so we make an atomic write the frame buffer.
@@ -338,42 +505,7 @@ Returns:
     SourceOffset  = (SourceY * Private->ModeData[CurrentMode].HorizontalResolution) + (SourceX);
     Offset        = (DestinationY * Private->ModeData[CurrentMode].HorizontalResolution) + (DestinationX);
 
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0000);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0010);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0012);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0014);
-
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0001);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0011);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0013);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0015);
-
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((Width << 8) & 0xff00) | 0x20));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((Width & 0xff00) | 0x21));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((Height << 8) & 0xff00) | 0x22));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((Height & 0xff00) | 0x23));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((ScreenWidth << 8) & 0xff00) | 0x24));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((ScreenWidth & 0xff00) | 0x25));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((ScreenWidth << 8) & 0xff00) | 0x26));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((ScreenWidth & 0xff00) | 0x27));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((Offset) << 8) & 0xff00) | 0x28));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((Offset) >> 0) & 0xff00) | 0x29));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((Offset) >> 8) & 0xff00) | 0x2a));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((SourceOffset) << 8) & 0xff00) | 0x2c));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((SourceOffset) >> 0) & 0xff00) | 0x2d));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((SourceOffset) >> 8) & 0xff00) | 0x2e));
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x002f);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0030);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0d32);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0033);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0034);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0035);
-
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0231);
-
-    outb (Private, GRAPH_ADDRESS_REGISTER, 0x31);
-    while ((inb (Private, GRAPH_DATA_REGISTER) & 0x01) == 0x01)
-      ;
+    CirrusLogic5430BitBlt (Private, SourceOffset, Offset, Width, Height, ScreenWidth);
     break;
 
   case EfiBltVideoFill:
@@ -430,8 +562,15 @@ Returns:
     break;
 
   case EfiBltBufferToVideo:
+    //
+    // Convert every line into the staging buffer first, then write the whole
+    // rectangle to VRAM.
+    //
     for (SrcY = SourceY, DstY = DestinationY; SrcY < (Height + SourceY); SrcY++, DstY++) {
 
+      Offset  = (DstY * Private->ModeData[CurrentMode].HorizontalResolution) + DestinationX;
+      Staging = Private->StagingBuffer + Offset;
+
       for (X = 0; X < Width; X++) {
         Blt =
           (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *) (
@@ -439,32 +578,11 @@ Returns:
               (SrcY * Delta) +
               ((SourceX + X) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL))
             );
-        Private->LineBuffer[X]  =
-          RGB_BYTES_TO_PIXEL (Blt->Red, Blt->Green, Blt->Blue);
-      }
-
-      Offset = (DstY * Private->ModeData[CurrentMode].HorizontalResolution) + DestinationX;
-
-      if (((Offset & 0x03) == 0) && ((Width & 0x03) == 0)) {
-        Private->PciIo->Mem.Write (
-                              Private->PciIo,
-                              EfiPciIoWidthUint32,
-                              0,
-                              Offset,
-                              Width >> 2,
-                              Private->LineBuffer
-                              );
-      } else {
-        Private->PciIo->Mem.Write (
-                              Private->PciIo,
-                              EfiPciIoWidthUint8,
-                              0,
-                              Offset,
-                              Width,
-                              Private->LineBuffer
-                              );
+        Staging[X] = RGB_BYTES_TO_PIXEL (Blt->Red, Blt->Green, Blt->Blue);
       }
     }
+
+    CirrusLogic5430FlushStaging (Private, DestinationX, DestinationY, Width, Height);
     break;
   default:
     ASSERT (FALSE);
@@ -512,6 +630,7 @@ CirrusLogic5430GraphicsOutputConstructor (
   Private->GraphicsOutput.Mode->Mode    = GRAPHICS_OUTPUT_INVALIDE_MODE_NUMBER;
   Private->HardwareNeedsStarting        = TRUE;
   Private->LineBuffer                   = NULL;
+  Private->StagingBuffer                = NULL;
 
   //
   // Initialize the hardware
@@ -550,6 +669,16 @@ Returns:
     gBS->FreePool (Private->GraphicsOutput.Mode);
   }
 
+  if (Private->LineBuffer != NULL) {
+    gBS->FreePool (Private->LineBuffer);
+    Private->LineBuffer = NULL;
+  }
+
+  if (Private->StagingBuffer != NULL) {
+    gBS->FreePool (Private->StagingBuffer);
+    Private->StagingBuffer = NULL;
+  }
+
   return EFI_SUCCESS;
 }
 
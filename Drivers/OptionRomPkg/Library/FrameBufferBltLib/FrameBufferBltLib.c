@@ -455,6 +455,22 @@ BltLibVideoToBltBufferEx (
 
   WidthInBytes = Width * mBltLibBytesPerPixel;
 
+  //
+  // Full width rectangle in a packed BltBuffer of the native format: the
+  // source and destination are both contiguous, so copy them in one shot.
+  //
+  if ((mPixelFormat == PixelBlueGreenRedReserved8BitPerColor) &&
+      (SourceX == 0) && (DestinationX == 0) &&
+      (Width == mBltLibWidthInPixels) && (Delta == WidthInBytes)) {
+    VDEBUG ((DEBUG_INFO, "VideoToBltBuffer (one-shot)\n"));
+    CopyMem (
+      (UINT8 *) BltBuffer + (DestinationY * Delta),
+      mBltLibFrameBuffer + (SourceY * mBltLibWidthInBytes),
+      WidthInBytes * Height
+      );
+    return EFI_SUCCESS;
+  }
+
   //
   // Video to BltBuffer: Source is Video, destination is BltBuffer
   //
@@ -477,7 +493,16 @@ BltLibVideoToBltBufferEx (
 
     CopyMem (BltMemDst, BltMemSrc, WidthInBytes);
 
-    if (mPixelFormat != PixelBlueGreenRedReserved8BitPerColor) {
+    if (mPixelFormat == PixelRedGreenBlueReserved8BitPerColor) {
+      //
+      // Only red and blue trade places, no need for the generic mask/shift.
+      //
+      Blt = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *) ((UINT8 *) BltBuffer + (DstY * Delta) + DestinationX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+      for (X = 0; X < Width; X++) {
+        Uint32 = ((UINT32 *) mBltLibLineBuffer)[X];
+        ((UINT32 *) Blt)[X] = ((Uint32 & 0xff) << 16) | (Uint32 & 0xff00) | ((Uint32 >> 16) & 0xff);
+      }
+    } else if (mPixelFormat != PixelBlueGreenRedReserved8BitPerColor) {
       for (X = 0; X < Width; X++) {
         Blt         = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *) ((UINT8 *) BltBuffer + (DstY * Delta) + (DestinationX + X) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
         Uint32 = *(UINT32*) (mBltLibLineBuffer + (X * mBltLibBytesPerPixel));
@@ -599,6 +624,22 @@ BltLibBufferToVideoEx (
 
   WidthInBytes = Width * mBltLibBytesPerPixel;
 
+  //
+  // Full width rectangle from a packed BltBuffer of the native format: the
+  // source and destination are both contiguous, so copy them in one shot.
+  //
+  if ((mPixelFormat == PixelBlueGreenRedReserved8BitPerColor) &&
+      (SourceX == 0) && (DestinationX == 0) &&
+      (Width == mBltLibWidthInPixels) && (Delta == WidthInBytes)) {
+    VDEBUG ((DEBUG_INFO, "BufferToVideo (one-shot)\n"));
+    CopyMem (
+      mBltLibFrameBuffer + (DestinationY * mBltLibWidthInBytes),
+      (UINT8 *) BltBuffer + (SourceY * Delta),
+      WidthInBytes * Height
+      );
+    return EFI_SUCCESS;
+  }
+
   for (SrcY = SourceY, DstY = DestinationY; SrcY < (Height + SourceY); SrcY++, DstY++) {
 
     Offset = (DstY * mBltLibWidthInPixels) + DestinationX;
@@ -606,7 +647,17 @@ BltLibBufferToVideoEx (
     BltMemDst = (VOID*) (mBltLibFrameBuffer + Offset);
 
     if (mPixelFormat == PixelBlueGreenRedReserved8BitPerColor) {
-      BltMemSrc = (VOID *) ((UINT8 *) BltBuffer + (SrcY * Delta));
+      BltMemSrc = (VOID *) ((UINT8 *) BltBuffer + (SrcY * Delta) + (SourceX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)));
+    } else if (mPixelFormat == PixelRedGreenBlueReserved8BitPerColor) {
+      //
+      // Only red and blue trade places, no need for the generic mask/shift.
+      //
+      Blt = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *) ((UINT8 *) BltBuffer + (SrcY * Delta) + (SourceX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)));
+      for (X = 0; X < Width; X++) {
+        Uint32 = ((UINT32 *) Blt)[X];
+        ((UINT32 *) mBltLibLineBuffer)[X] = ((Uint32 & 0xff) << 16) | (Uint32 & 0xff00) | ((Uint32 >> 16) & 0xff);
+      }
+      BltMemSrc = (VOID *) mBltLibLineBuffer;
     } else {
       for (X = 0; X < Width; X++) {
         Blt =
@@ -698,8 +749,24 @@ BltLibVideoToVideo (
   Offset = mBltLibBytesPerPixel * Offset;
   BltMemDst = (VOID *) (mBltLibFrameBuffer + Offset);
 
+  //
+  // Full width scrolling moves one contiguous block, and CopyMem handles
+  // the overlap.
+  //
+  if ((SourceX == 0) && (DestinationX == 0) && (Width == mBltLibWidthInPixels)) {
+    VDEBUG ((DEBUG_INFO, "VideoToVideo (one-shot)\n"));
+    CopyMem (BltMemDst, BltMemSrc, WidthInBytes * Height);
+    return EFI_SUCCESS;
+  }
+
+  //
+  // When moving down, copy from the bottom line up so that source lines
+  // are read before they are overwritten.
+  //
   LineStride = mBltLibWidthInBytes;
   if ((UINTN) BltMemDst > (UINTN) BltMemSrc) {
+    BltMemSrc = (VOID*) ((UINT8*) BltMemSrc + (Height - 1) * mBltLibWidthInBytes);
+    BltMemDst = (VOID*) ((UINT8*) BltMemDst + (Height - 1) * mBltLibWidthInBytes);
     LineStride = -LineStride;
   }
 
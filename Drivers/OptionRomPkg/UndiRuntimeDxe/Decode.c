@@ -247,9 +247,9 @@ UNDI_GetInitInfo (
   DbPtr->HWaddrLen = PXE_HWADDR_LEN_ETHER;
   DbPtr->MCastFilterCnt = MAX_MCAST_ADDRESS_CNT;
 
-  DbPtr->TxBufCnt = TX_BUFFER_COUNT;
+  DbPtr->TxBufCnt = E100B_TX_RING_SIZE;
   DbPtr->TxBufSize = (UINT16) sizeof (TxCB);
-  DbPtr->RxBufCnt = RX_BUFFER_COUNT;
+  DbPtr->RxBufCnt = E100B_RX_RING_SIZE;
   DbPtr->RxBufSize = (UINT16) sizeof (RxFD);
 
   DbPtr->IFtype = PXE_IFTYPE_ETHERNET;
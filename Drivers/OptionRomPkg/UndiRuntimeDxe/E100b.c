@@ -445,6 +445,32 @@ IssueCB (
   )
 {
   UINT16  status;
+  TxCB    *prev_ptr;
+
+  //
+  // If the CB before the previous one has not completed yet, the CU has not
+  // fetched the previous CB. Clearing the suspend bit there is then enough
+  // for the CU to run on into this CB, so frames queued while the CU is busy
+  // are chained behind a single start or resume. The status is checked again
+  // after the store to close the race with the CU moving on.
+  //
+  // This relies on the CU not prefetching past a suspended CB: it must read
+  // the command word of the previous CB only after completing the one before
+  // it. The fence before the store makes sure this CB is fully written before
+  // the CU can see the cleared suspend bit, the fence after it orders the
+  // store against the status read back.
+  //
+  prev_ptr = cmd_ptr->PrevTCBVirtualLinkPtr;
+  if ((prev_ptr->cb_header.command != 0) &&
+      (prev_ptr->PrevTCBVirtualLinkPtr->cb_header.command != 0) &&
+      ((prev_ptr->PrevTCBVirtualLinkPtr->cb_header.status & CMD_STATUS_MASK) == 0)) {
+    MemoryFence ();
+    prev_ptr->cb_header.command &= ~(CmdSuspend | CmdIntr);
+    MemoryFence ();
+    if ((prev_ptr->PrevTCBVirtualLinkPtr->cb_header.status & CMD_STATUS_MASK) == 0) {
+      return 0;
+    }
+  }
 
   wait_for_cmd_done (AdapterInfo->ioaddr + SCBCmd);
 
@@ -481,7 +507,7 @@ IssueCB (
     // either active or suspended, give a resume
     //
 
-    cmd_ptr->PrevTCBVirtualLinkPtr->cb_header.command &= ~(CmdSuspend | CmdIntr);
+    prev_ptr->cb_header.command &= ~(CmdSuspend | CmdIntr);
     OutByte (AdapterInfo, CU_RESUME, AdapterInfo->ioaddr + SCBCmd);
   }
 
@@ -761,8 +787,8 @@ E100bInit (
   // ## calculate the rx and tx ring pointers
   //
 
-  AdapterInfo->TxBufCnt       = TX_BUFFER_COUNT;
-  AdapterInfo->RxBufCnt       = RX_BUFFER_COUNT;
+  AdapterInfo->TxBufCnt       = E100B_TX_RING_SIZE;
+  AdapterInfo->RxBufCnt       = E100B_RX_RING_SIZE;
   rx_size                     = (AdapterInfo->RxBufCnt * sizeof (RxFD));
   tx_size                     = (AdapterInfo->TxBufCnt * sizeof (TxCB));
   AdapterInfo->rx_ring        = (RxFD *) (UINTN) (AdapterInfo->MemoryPtr);
@@ -1335,6 +1361,17 @@ FreeRFD:
     rx_ptr = &AdapterInfo->rx_ring[AdapterInfo->cur_rx_ind];
   }
 
+  //
+  // once the ring is drained, hand all consumed RFDs back so that an idle
+  // RU has the whole ring available
+  //
+  if ((AdapterInfo->rx_ring[AdapterInfo->cur_rx_ind].cb_header.status & RX_COMPLETE) == 0) {
+    Flush_RFD (
+      AdapterInfo,
+      (UINT16) ((AdapterInfo->cur_rx_ind == 0) ? (AdapterInfo->RxBufCnt - 1) : (AdapterInfo->cur_rx_ind - 1))
+      );
+  }
+
   if (pkt_type == PXE_FRAME_TYPE_NONE) {
     AdapterInfo->Int_Status &= (~SCB_STATUS_FR);
   }
@@ -1545,6 +1582,7 @@ SetFreeCB (
   // and we link the newly freed cb at the tail of free cb list
   //
   cb_ptr->cb_header.status    = 0;
+  cb_ptr->cb_header.command   = 0;
   cb_ptr->free_data_ptr       = (UINT64) 0;
 
   AdapterInfo->FreeTxTailPtr  = cb_ptr;
@@ -1650,8 +1688,9 @@ SetupReceiveQueues (
   RxFD    *tail_ptr;
   UINT16  Index;
 
-  AdapterInfo->cur_rx_ind = 0;
-  rx_ptr                  = (&AdapterInfo->rx_ring[0]);
+  AdapterInfo->cur_rx_ind       = 0;
+  AdapterInfo->RxRecyclePending = 0;
+  rx_ptr                        = (&AdapterInfo->rx_ring[0]);
 
   for (Index = 0; Index < AdapterInfo->RxBufCnt; Index++) {
     rx_ptr[Index].cb_header.status  = 0;
@@ -1704,29 +1743,60 @@ Recycle_RFD (
   )
 {
   RxFD  *rx_ptr;
-  RxFD  *tail_ptr;
+  UINT16 batch;
+
   //
-  // change the EL bit and change the AdapterInfo->RxTailPtr
+  // reset the RFD but leave the EL bit where it is; the RU cannot reach
+  // this RFD until Flush_RFD moves the EL bit past it
   // rx_ptr is assumed to be the head of the Q
-  // AdapterInfo->rx_forwarded[rx_index] = FALSE;
-  //
-  rx_ptr                    = &AdapterInfo->rx_ring[rx_index];
-  tail_ptr                  = AdapterInfo->RFDTailPtr;
-  //
-  // set el_bit and suspend bit
   //
-  rx_ptr->cb_header.command = 0xc000;
+  rx_ptr                      = &AdapterInfo->rx_ring[rx_index];
+  rx_ptr->cb_header.command   = 0;
   rx_ptr->cb_header.status    = 0;
   rx_ptr->ActualCount         = 0;
   rx_ptr->forwarded           = FALSE;
-  AdapterInfo->RFDTailPtr     = rx_ptr;
-  //
-  // resetting the el_bit.
-  //
-  tail_ptr->cb_header.command = 0;
+
+  batch = (UINT16) MIN (RX_RECYCLE_BATCH, AdapterInfo->RxBufCnt >> 2);
+  if (++AdapterInfo->RxRecyclePending >= batch) {
+    Flush_RFD (AdapterInfo, rx_index);
+  }
+
+  return ;
+}
+
+
+/**
+  Hand all recycled RFDs back to the receive unit at once by moving the EL
+  bit from the current tail to the last recycled RFD.
+
+  @param  AdapterInfo                     Pointer to the NIC data structure.
+  @param  rx_index                        Index of the last recycled RFD.
+
+**/
+VOID
+Flush_RFD (
+  IN NIC_DATA_INSTANCE *AdapterInfo,
+  IN UINT16            rx_index
+  )
+{
+  RxFD  *rx_ptr;
+  RxFD  *tail_ptr;
+
+  if (AdapterInfo->RxRecyclePending == 0) {
+    return ;
+  }
+
+  rx_ptr                        = &AdapterInfo->rx_ring[rx_index];
+  tail_ptr                      = AdapterInfo->RFDTailPtr;
   //
-  // check the receive unit, fix if there is any problem
+  // set el_bit and suspend bit on the new tail before resetting the el_bit
+  // of the old one, so the RU never runs past the recycled RFDs
   //
+  rx_ptr->cb_header.command     = 0xc000;
+  AdapterInfo->RFDTailPtr       = rx_ptr;
+  MemoryFence ();
+  tail_ptr->cb_header.command   = 0;
+  AdapterInfo->RxRecyclePending = 0;
   return ;
 }
 //
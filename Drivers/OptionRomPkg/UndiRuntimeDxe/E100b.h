@@ -14,6 +14,18 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define RX_BUFFER_COUNT 32
 #define TX_BUFFER_COUNT 32
 
+//
+// Number of RFDs and CBs actually used, set by PCD and bounded by the ring
+// arrays above.
+//
+#define E100B_RX_RING_SIZE  ((UINT16) MIN (MAX (PcdGet16 (PcdUndiRxBufferCount), 4), RX_BUFFER_COUNT))
+#define E100B_TX_RING_SIZE  ((UINT16) MIN (MAX (PcdGet16 (PcdUndiTxBufferCount), 4), TX_BUFFER_COUNT))
+
+//
+// Consumed RFDs are handed back to the RU in batches of up to this many.
+//
+#define RX_RECYCLE_BATCH    8
+
 #define PCI_VENDOR_ID_INTEL 0x8086
 #define PCI_DEVICE_ID_INTEL_82557 0x1229
 #define D100_VENDOR_ID   0x8086
@@ -612,6 +624,7 @@ typedef struct s_data_instance {
   UINT16 xmit_done_head;  // index into the xmit_done array
   UINT16 xmit_done_tail;  // where are we filling now (index into xmit_done)
   UINT16 cur_rx_ind;  // current RX Q head index
+  UINT16 RxRecyclePending;  // consumed RFDs not yet handed back to the RU
   UINT16 FreeCBCount;
 
   BOOLEAN in_interrupt;
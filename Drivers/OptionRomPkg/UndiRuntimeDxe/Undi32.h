@@ -26,6 +26,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/BaseLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/PcdLib.h>
 
 #include <IndustryStandard/Pci.h>
 
@@ -127,6 +128,7 @@ UINT8 SelectiveReset (NIC_DATA_INSTANCE *AdapterInfo);
 UINT16 InitializeChip (NIC_DATA_INSTANCE *AdapterInfo);
 UINT8 SetupReceiveQueues (NIC_DATA_INSTANCE *AdapterInfo);
 VOID  Recycle_RFD (NIC_DATA_INSTANCE *AdapterInfo, UINT16);
+VOID  Flush_RFD (NIC_DATA_INSTANCE *AdapterInfo, UINT16);
 VOID XmitWaitForCompletion (NIC_DATA_INSTANCE *AdapterInfo);
 INT8 CommandWaitForCompletion (TxCB *cmd_ptr, NIC_DATA_INSTANCE *AdapterInfo);
 
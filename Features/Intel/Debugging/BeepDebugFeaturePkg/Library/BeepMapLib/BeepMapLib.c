@@ -53,7 +53,7 @@ STATUS_CODE_TO_DATA_MAP mBeepErrorMap[] = {
   {0,0}
 };
 
-STATUS_CODE_TO_DATA_MAP *mBeepStatusCodesMap[] = {
+STATUS_CODE_TO_DATA_MAP *mBeepStatusCodesMap[BEEP_MAP_TYPES] = {
   //#define EFI_PROGRESS_CODE 0x00000001
   mBeepProgressMap,
   //#define EFI_ERROR_CODE 0x00000002
@@ -112,5 +112,5 @@ GetBeepValueFromStatusCode (
     return 0;
   }
 
-  return FindBeepData (mBeepStatusCodesMap[CodeTypeIndex], Value);
+  return LookupBeepData (CodeTypeIndex, Value);
 }
@@ -0,0 +1,83 @@
+/** @file
+  Sorted lookup of the beep maps for DXE and SMM.
+
+  The library constructor sorts the maps once by status code value and lookups
+  binary search them afterwards.
+
+  Copyright (c) 2012 - 2020, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Base.h>
+#include <Uefi.h>
+#include <Library/StatusCodeMapLib.h>
+
+#include "PlatformStatusCodesInternal.h"
+
+//
+// Number of entries in each mBeepStatusCodesMap[] table, not counting the
+// {0,0} terminator. Valid only once mBeepMapsSorted is TRUE.
+//
+STATIC UINTN   mBeepMapCount[BEEP_MAP_TYPES];
+
+//
+// Set by the constructor after the maps have been sorted. Lookups that happen
+// before that scan the maps linearly.
+//
+STATIC BOOLEAN mBeepMapsSorted = FALSE;
+
+/**
+  Sort every beep map by Value so that lookups can binary search them.
+
+  @retval RETURN_SUCCESS   The maps were sorted.
+
+**/
+RETURN_STATUS
+EFIAPI
+BeepMapLibConstructor (
+  VOID
+  )
+{
+  UINTN  MapIndex;
+
+  for (MapIndex = 0; MapIndex < BEEP_MAP_TYPES; MapIndex++) {
+    mBeepMapCount[MapIndex] = SortStatusCodeMap (
+                                mBeepStatusCodesMap[MapIndex],
+                                sizeof (STATUS_CODE_TO_DATA_MAP),
+                                OFFSET_OF (STATUS_CODE_TO_DATA_MAP, Value)
+                                );
+  }
+
+  mBeepMapsSorted = TRUE;
+  return RETURN_SUCCESS;
+}
+
+/**
+  Look up the beep data of a status code value in one of the maps.
+
+  @param  MapIndex         Index of the map in mBeepStatusCodesMap[].
+  @param  Value            The status code value.
+
+  @return BeepValue        0 for not found.
+
+**/
+UINT32
+LookupBeepData (
+  IN UINTN                   MapIndex,
+  IN EFI_STATUS_CODE_VALUE   Value
+  )
+{
+  if (!mBeepMapsSorted) {
+    return FindBeepData (mBeepStatusCodesMap[MapIndex], Value);
+  }
+
+  return SearchStatusCodeMap (
+           mBeepStatusCodesMap[MapIndex],
+           mBeepMapCount[MapIndex],
+           sizeof (STATUS_CODE_TO_DATA_MAP),
+           OFFSET_OF (STATUS_CODE_TO_DATA_MAP, Value),
+           OFFSET_OF (STATUS_CODE_TO_DATA_MAP, Data),
+           Value
+           );
+}
@@ -267,4 +267,44 @@ typedef struct{
 #define DXE_NO_CON_OUT                        (EFI_PERIPHERAL_LOCAL_CONSOLE | EFI_P_EC_NOT_DETECTED)
 #define DXE_NO_CON_IN                         (EFI_PERIPHERAL_KEYBOARD | EFI_P_EC_NOT_DETECTED)
 
+//
+// Number of status code types that have a map: progress and error codes.
+//
+#define BEEP_MAP_TYPES                    2
+
+extern STATUS_CODE_TO_DATA_MAP *mBeepStatusCodesMap[BEEP_MAP_TYPES];
+
+/**
+  Find the beep data from status code value.
+
+  @param  Map              The map used to find in.
+  @param  Value            The status code value.
+
+  @return BeepValue        0 for not found.
+
+**/
+UINT32
+FindBeepData (
+  IN STATUS_CODE_TO_DATA_MAP *Map,
+  IN EFI_STATUS_CODE_VALUE   Value
+  );
+
+/**
+  Look up the beep data of a status code value in one of the maps.
+
+  Each library instance provides its own lookup: a linear scan where the maps
+  may live in flash, or a binary search of maps sorted by the constructor.
+
+  @param  MapIndex         Index of the map in mBeepStatusCodesMap[].
+  @param  Value            The status code value.
+
+  @return BeepValue        0 for not found.
+
+**/
+UINT32
+LookupBeepData (
+  IN UINTN                   MapIndex,
+  IN EFI_STATUS_CODE_VALUE   Value
+  );
+
 #endif
@@ -0,0 +1,83 @@
+/** @file
+  Sorted lookup of the post code maps for DXE and SMM.
+
+  The library constructor sorts the maps once by status code value and lookups
+  binary search them afterwards.
+
+  Copyright (c) 2010 - 2020, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Base.h>
+#include <Uefi.h>
+#include <Library/StatusCodeMapLib.h>
+
+#include "PlatformStatusCodesInternal.h"
+
+//
+// Number of entries in each mPostCodeStatusCodesMap[] table, not counting the
+// {0,0} terminator. Valid only once mPostCodeMapsSorted is TRUE.
+//
+STATIC UINTN   mPostCodeMapCount[POST_CODE_MAP_TYPES];
+
+//
+// Set by the constructor after the maps have been sorted. Lookups that happen
+// before that scan the maps linearly.
+//
+STATIC BOOLEAN mPostCodeMapsSorted = FALSE;
+
+/**
+  Sort every post code map by Value so that lookups can binary search them.
+
+  @retval RETURN_SUCCESS   The maps were sorted.
+
+**/
+RETURN_STATUS
+EFIAPI
+PostCodeMapLibConstructor (
+  VOID
+  )
+{
+  UINTN  MapIndex;
+
+  for (MapIndex = 0; MapIndex < POST_CODE_MAP_TYPES; MapIndex++) {
+    mPostCodeMapCount[MapIndex] = SortStatusCodeMap (
+                                    mPostCodeStatusCodesMap[MapIndex],
+                                    sizeof (STATUS_CODE_TO_DATA_MAP),
+                                    OFFSET_OF (STATUS_CODE_TO_DATA_MAP, Value)
+                                    );
+  }
+
+  mPostCodeMapsSorted = TRUE;
+  return RETURN_SUCCESS;
+}
+
+/**
+  Look up the post code data of a status code value in one of the maps.
+
+  @param  MapIndex         Index of the map in mPostCodeStatusCodesMap[].
+  @param  Value            The status code value.
+
+  @return PostCode         0 for not found.
+
+**/
+UINT32
+LookupPostCodeData (
+  IN UINTN                   MapIndex,
+  IN EFI_STATUS_CODE_VALUE   Value
+  )
+{
+  if (!mPostCodeMapsSorted) {
+    return FindPostCodeData (mPostCodeStatusCodesMap[MapIndex], Value);
+  }
+
+  return SearchStatusCodeMap (
+           mPostCodeStatusCodesMap[MapIndex],
+           mPostCodeMapCount[MapIndex],
+           sizeof (STATUS_CODE_TO_DATA_MAP),
+           OFFSET_OF (STATUS_CODE_TO_DATA_MAP, Value),
+           OFFSET_OF (STATUS_CODE_TO_DATA_MAP, Data),
+           Value
+           );
+}
@@ -143,7 +143,7 @@ STATUS_CODE_TO_DATA_MAP mPostCodeErrorMap[] = {
   {0,0}
 };
 
-STATUS_CODE_TO_DATA_MAP *mPostCodeStatusCodesMap[] = {
+STATUS_CODE_TO_DATA_MAP *mPostCodeStatusCodesMap[POST_CODE_MAP_TYPES] = {
   //#define EFI_PROGRESS_CODE 0x00000001
   mPostCodeProgressMap,
   //#define EFI_ERROR_CODE 0x00000002
@@ -203,5 +203,5 @@ GetPostCodeFromStatusCode (
     return 0;
   }
 
-  return FindPostCodeData (mPostCodeStatusCodesMap[CodeTypeIndex], Value);
+  return LookupPostCodeData (CodeTypeIndex, Value);
 }
@@ -0,0 +1,33 @@
+/** @file
+  Linear lookup of the post code maps.
+
+  This instance may execute in place from flash where the maps cannot be
+  reordered, so it scans them as they are.
+
+  Copyright (c) 2010 - 2020, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Base.h>
+#include <Uefi.h>
+
+#include "PlatformStatusCodesInternal.h"
+
+/**
+  Look up the post code data of a status code value in one of the maps.
+
+  @param  MapIndex         Index of the map in mPostCodeStatusCodesMap[].
+  @param  Value            The status code value.
+
+  @return PostCode         0 for not found.
+
+**/
+UINT32
+LookupPostCodeData (
+  IN UINTN                   MapIndex,
+  IN EFI_STATUS_CODE_VALUE   Value
+  )
+{
+  return FindPostCodeData (mPostCodeStatusCodesMap[MapIndex], Value);
+}
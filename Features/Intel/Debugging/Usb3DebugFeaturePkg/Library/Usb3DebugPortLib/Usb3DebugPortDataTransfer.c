@@ -722,6 +722,7 @@ Usb3DebugPortDataTransfer (
   UINT32                          Dcctrl;
   EFI_PHYSICAL_ADDRESS            UsbBase;
   UINTN                           BytesToSend;
+  UINTN                           MaxBytesToSend;
   USB3_DEBUG_PORT_CONTROLLER      UsbDebugPort;
   EFI_STATUS                      Status;
   USB3_DEBUG_PORT_INSTANCE        UsbDbgInstance;
@@ -832,9 +833,18 @@ Usb3DebugPortDataTransfer (
     }
   }
 
+  //
+  // Coalesce output into large TRBs. Input keeps the original transfer size.
+  //
+  if (Direction == EfiUsbDataOut) {
+    MaxBytesToSend = XHC_DEBUG_PORT_OUT_DATA_LENGTH;
+  } else {
+    MaxBytesToSend = XHC_DEBUG_PORT_DATA_LENGTH;
+  }
+
   BytesToSend = 0;
   while (*Length > 0) {
-    BytesToSend = ((*Length) > XHC_DEBUG_PORT_DATA_LENGTH) ? XHC_DEBUG_PORT_DATA_LENGTH : *Length;
+    BytesToSend = ((*Length) > MaxBytesToSend) ? MaxBytesToSend : *Length;
     XhcDataTransfer (
       Instance,
       Direction,
@@ -591,7 +591,7 @@ InitializeUsb3DebugPort (
   //
   // Init data buffer used to transfer
   //
-  Instance->Urb.Data = (EFI_PHYSICAL_ADDRESS) (UINTN) AllocateAlignBuffer (XHC_DEBUG_PORT_DATA_LENGTH);
+  Instance->Urb.Data = (EFI_PHYSICAL_ADDRESS) (UINTN) AllocateAlignBuffer (XHC_DEBUG_PORT_BUFFER_LENGTH);
 
   //
   // Init DCDDI1 and DCDDI2
@@ -143,7 +143,7 @@ Usb3MapDmaBuffers (
   Usb3MapOneDmaBuffer (
     PciIo,
     Instance->Urb.Data,
-    XHC_DEBUG_PORT_DATA_LENGTH
+    XHC_DEBUG_PORT_BUFFER_LENGTH
     );
 
   Usb3MapOneDmaBuffer (
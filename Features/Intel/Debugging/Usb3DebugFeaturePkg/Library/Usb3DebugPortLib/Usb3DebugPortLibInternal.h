@@ -61,6 +61,17 @@
 //
 #define XHC_DEBUG_PORT_DATA_LENGTH   8
 
+//
+// Output is sent in TRBs of up to this size, so a typical DEBUG() line costs
+// a single doorbell and completion rather than one round trip per 8 bytes.
+//
+#define XHC_DEBUG_PORT_OUT_DATA_LENGTH  1024
+
+//
+// Size of the URB data buffer, large enough for either direction
+//
+#define XHC_DEBUG_PORT_BUFFER_LENGTH    MAX (XHC_DEBUG_PORT_DATA_LENGTH, XHC_DEBUG_PORT_OUT_DATA_LENGTH)
+
 //
 // Indicate the timeout when data is transferred. 0 means infinite timeout.
 //
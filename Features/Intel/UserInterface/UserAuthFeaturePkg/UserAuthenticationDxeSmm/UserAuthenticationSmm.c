@@ -15,6 +15,105 @@ BOOLEAN                         mNeedReVerify = TRUE;
 BOOLEAN                         mPasswordVerified = FALSE;
 EFI_HANDLE                      mSmmHandle = NULL;
 
+BOOLEAN                         mPasswordCacheEnabled = FALSE;
+UINT8                           mPasswordCacheKey[PASSWORD_SALT_SIZE];
+VERIFIED_PASSWORD_CACHE         mVerifiedPasswordCache;
+
+/**
+  Calculate the tag identifying a password in the verified password cache.
+
+  The tag is an HMAC of the password under a key generated at every boot, so
+  it is cheap to compute but cannot be used to check guesses outside SMRAM.
+
+  @param[in]   Password               The user input password.
+  @param[in]   PasswordSize           The size of Password in byte.
+  @param[out]  PasswordTag            The tag of the password.
+
+  @retval TRUE    The tag is calculated.
+  @retval FALSE   The tag is not calculated.
+**/
+BOOLEAN
+GetPasswordCacheTag (
+  IN  CHAR8                         *Password,
+  IN  UINTN                         PasswordSize,
+  OUT UINT8                         *PasswordTag
+  )
+{
+  if (!mPasswordCacheEnabled) {
+    return FALSE;
+  }
+
+  return HmacSha256All (
+           Password,
+           PasswordSize,
+           mPasswordCacheKey,
+           sizeof (mPasswordCacheKey),
+           PasswordTag
+           );
+}
+
+/**
+  Remember a password which matches a password hash in the variable region.
+
+  @param[in]  Password               The user input password.
+  @param[in]  PasswordSize           The size of Password in byte.
+  @param[in]  UserPasswordVarStruct  The storage of password in variable.
+**/
+VOID
+CacheVerifiedPassword (
+  IN CHAR8                          *Password,
+  IN UINTN                          PasswordSize,
+  IN USER_PASSWORD_VAR_STRUCT       *UserPasswordVarStruct
+  )
+{
+  ZeroMem (&mVerifiedPasswordCache, sizeof (mVerifiedPasswordCache));
+  if (!GetPasswordCacheTag (Password, PasswordSize, mVerifiedPasswordCache.PasswordTag)) {
+    return;
+  }
+
+  CopyMem (mVerifiedPasswordCache.PasswordHash, UserPasswordVarStruct->PasswordHash, PASSWORD_HASH_SIZE);
+  mVerifiedPasswordCache.Valid = TRUE;
+}
+
+/**
+  Check whether a password was already verified against a password hash in this boot.
+
+  Only passwords that passed the PBKDF2 verification are cached, so a wrong
+  password is always checked at full cost.
+
+  @param[in]  Password               The user input password.
+  @param[in]  PasswordSize           The size of Password in byte.
+  @param[in]  UserPasswordVarStruct  The storage of password in variable.
+
+  @retval TRUE    The password is known to match UserPasswordVarStruct.
+  @retval FALSE   The password must be verified with PBKDF2.
+**/
+BOOLEAN
+IsPasswordCached (
+  IN CHAR8                          *Password,
+  IN UINTN                          PasswordSize,
+  IN USER_PASSWORD_VAR_STRUCT       *UserPasswordVarStruct
+  )
+{
+  UINT8    PasswordTag[SHA256_DIGEST_SIZE];
+  BOOLEAN  Cached;
+
+  if (!mVerifiedPasswordCache.Valid) {
+    return FALSE;
+  }
+  if (KeyLibSlowCompareMem (mVerifiedPasswordCache.PasswordHash, UserPasswordVarStruct->PasswordHash, PASSWORD_HASH_SIZE) != 0) {
+    return FALSE;
+  }
+  if (!GetPasswordCacheTag (Password, PasswordSize, PasswordTag)) {
+    return FALSE;
+  }
+
+  Cached = (BOOLEAN)(KeyLibSlowCompareMem (mVerifiedPasswordCache.PasswordTag, PasswordTag, sizeof (PasswordTag)) == 0);
+  ZeroMem (PasswordTag, sizeof (PasswordTag));
+
+  return Cached;
+}
+
 /**
   Verify if the password is correct.
 
@@ -35,6 +134,10 @@ VerifyPassword (
   BOOLEAN  HashOk;
   UINT8    HashData[PASSWORD_HASH_SIZE];
 
+  if (IsPasswordCached (Password, PasswordSize, UserPasswordVarStruct)) {
+    return EFI_SUCCESS;
+  }
+
   HashOk = KeyLibGeneratePBKDF2Hash (
              HASH_TYPE_SHA256,
              (UINT8 *)Password,
@@ -48,6 +151,7 @@ VerifyPassword (
     return EFI_DEVICE_ERROR;
   }
   if (KeyLibSlowCompareMem (UserPasswordVarStruct->PasswordHash, HashData, PASSWORD_HASH_SIZE) == 0) {
+    CacheVerifiedPassword (Password, PasswordSize, UserPasswordVarStruct);
     return EFI_SUCCESS;
   } else {
     return EFI_SECURITY_VIOLATION;
@@ -109,6 +213,8 @@ SavePasswordHashToVariable (
 {
   EFI_STATUS                        Status;
 
+  ZeroMem (&mVerifiedPasswordCache, sizeof (mVerifiedPasswordCache));
+
   if (UserPasswordVarStruct == NULL) {
     Status = mSmmVariable->SmmSetVariable (
                              USER_AUTHENTICATION_VAR_NAME,
@@ -249,6 +355,11 @@ SavePasswordToVariable (
     //
     if (!EFI_ERROR(Status)) {
       SaveOldPasswordToHistory (UserGuid, &UserPasswordVarStruct);
+      //
+      // The new password is verified by construction, so a following
+      // VERIFY_PASSWORD does not need to hash it again.
+      //
+      CacheVerifiedPassword (Password, PasswordSize, &UserPasswordVarStruct);
     }
   } else {
     Status = SavePasswordHashToVariable (UserGuid, NULL);
@@ -754,6 +865,10 @@ UaExitBootServices (
 
   gMmst->MmiHandlerUnRegister(mSmmHandle);
 
+  mPasswordCacheEnabled = FALSE;
+  ZeroMem (mPasswordCacheKey, sizeof (mPasswordCacheKey));
+  ZeroMem (&mVerifiedPasswordCache, sizeof (mVerifiedPasswordCache));
+
   return EFI_SUCCESS;
 }
 
@@ -782,6 +897,15 @@ PasswordSmmInit (
   Status = gMmst->MmLocateProtocol (&gEfiSmmVariableProtocolGuid, NULL, (VOID**)&mSmmVariable);
   ASSERT_EFI_ERROR (Status);
 
+  //
+  // Without a random key the verified password cache is not used, and every
+  // verification runs PBKDF2.
+  //
+  mPasswordCacheEnabled = KeyLibGenerateSalt (mPasswordCacheKey, sizeof (mPasswordCacheKey));
+  if (!mPasswordCacheEnabled) {
+    DEBUG ((DEBUG_WARN, "PasswordSmmInit: verified password cache disabled\n"));
+  }
+
   //
   // Make password variables read-only for DXE driver for security concern.
   //
@@ -40,6 +40,15 @@ typedef struct {
   UINT8        PasswordSalt[PASSWORD_SALT_SIZE];
 } USER_PASSWORD_VAR_STRUCT;
 
+//
+// Last password verified in this boot, kept in SMRAM only
+//
+typedef struct {
+  BOOLEAN      Valid;
+  UINT8        PasswordHash[PASSWORD_HASH_SIZE];  // Variable hash it was verified against
+  UINT8        PasswordTag[SHA256_DIGEST_SIZE];   // HMAC-SHA256 of the password
+} VERIFIED_PASSWORD_CACHE;
+
 /**
   Password Smm Init.
 
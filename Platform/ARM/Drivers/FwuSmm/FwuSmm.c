@@ -732,8 +732,9 @@ FwuSmmCancelStaging (
   ASSERT (Status == EFI_SUCCESS);
 
   /**
-   * In the implementation, all of write buffer is written on storage
-   * in fwu_write_stream.
+   * In the implementation, write buffer is written on storage
+   * in fwu_write_stream (whole blocks) and when the image is released
+   * (remainder), so part of the image may already be on storage.
    * So, if we cancel the staging, we couldn't boot with using update indexed
    * bank (In A/B firmware storage design, update index == previous index).
    *
@@ -1069,6 +1070,11 @@ FwuSmmCommit (
     ASSERT (Status == EFI_SUCCESS);
   }
 
+  /**
+   * FwsRelease drains the data staged by fwu_write_stream.
+   * fwu_end_staging requires every handle to be committed first,
+   * so nothing is left staged once the staging ends.
+   */
   Status = FwsRelease (
              Ifd->ImageFile,
              ReqData->MaxAtomicLen,
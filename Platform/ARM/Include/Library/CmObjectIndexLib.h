@@ -0,0 +1,152 @@
+/** @file
+  Hashed index of Configuration Manager objects.
+
+  The DynamicTables generators resolve the same (ObjectId, Token) pairs many
+  times while building the ACPI tables. A Configuration Manager can record
+  each resolved pair in this index so that later queries for it are answered
+  in constant time instead of by a linear search of the platform repository.
+
+  Copyright (c) 2025, Arm Limited. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef CM_OBJECT_INDEX_LIB_H_
+#define CM_OBJECT_INDEX_LIB_H_
+
+#include <ConfigurationManagerObject.h>
+#include <Protocol/ConfigurationManagerProtocol.h>
+
+/** Number of entries a Configuration Manager should size its index for.
+
+  This comfortably covers the tokens referenced by the ACPI tables of the
+  Arm reference platforms.
+*/
+#define CM_OBJECT_INDEX_DEFAULT_MAX_ENTRIES  256
+
+/** Opaque Configuration Manager object index.
+*/
+typedef struct CmObjectIndex CM_OBJECT_INDEX;
+
+/** Platform handler that searches the platform repository for the
+    object(s) referenced by a token.
+
+  @param [in]  This               Pointer to the Configuration Manager Protocol.
+  @param [in]  CmObjectId         The Configuration Manager Object ID.
+  @param [in]  Token              A token identifying the object(s).
+  @param [in, out]  CmObject      Pointer to the Configuration Manager Object
+                                  descriptor describing the requested Object.
+
+  @retval EFI_SUCCESS           Success.
+  @retval EFI_INVALID_PARAMETER A parameter is invalid.
+  @retval EFI_NOT_FOUND         The required object information is not found.
+**/
+typedef EFI_STATUS (*CM_OBJECT_INDEX_HANDLER) (
+  IN  CONST EDKII_CONFIGURATION_MANAGER_PROTOCOL  * CONST This,
+  IN  CONST CM_OBJECT_ID                                  CmObjectId,
+  IN  CONST CM_OBJECT_TOKEN                               Token,
+  IN  OUT   CM_OBJ_DESCRIPTOR                     * CONST CmObject
+  );
+
+/** Create an empty object index.
+
+  @param [in]  MaxEntries   Maximum number of (ObjectId, Token) pairs the
+                            index must be able to hold.
+  @param [out] Index        Receives the new index.
+
+  @retval EFI_SUCCESS           Success.
+  @retval EFI_INVALID_PARAMETER A parameter is invalid.
+  @retval EFI_OUT_OF_RESOURCES  Memory allocation failed.
+**/
+EFI_STATUS
+EFIAPI
+CmObjectIndexCreate (
+  IN  UINTN            MaxEntries,
+  OUT CM_OBJECT_INDEX  **Index
+  );
+
+/** Free an object index.
+
+  @param [in]  Index    The index to free. May be NULL.
+**/
+VOID
+EFIAPI
+CmObjectIndexFree (
+  IN  CM_OBJECT_INDEX  *Index
+  );
+
+/** Record the object(s) returned for an (ObjectId, Token) pair.
+
+  If the pair is already present its descriptor is replaced.
+
+  @param [in]  Index          The object index.
+  @param [in]  Token          The token the object(s) were requested with.
+  @param [in]  CmObjectDesc   Descriptor of the object(s). The ObjectId field
+                              is part of the key.
+
+  @retval EFI_SUCCESS           Success.
+  @retval EFI_INVALID_PARAMETER A parameter is invalid.
+  @retval EFI_OUT_OF_RESOURCES  The index is full.
+**/
+EFI_STATUS
+EFIAPI
+CmObjectIndexAdd (
+  IN        CM_OBJECT_INDEX           *Index,
+  IN  CONST CM_OBJECT_TOKEN           Token,
+  IN  CONST CM_OBJ_DESCRIPTOR * CONST CmObjectDesc
+  );
+
+/** Look up the object(s) recorded for an (ObjectId, Token) pair.
+
+  @param [in]  Index          The object index.
+  @param [in]  CmObjectId     The Configuration Manager Object ID.
+  @param [in]  Token          The token identifying the object(s).
+  @param [out] CmObjectDesc   Receives the recorded descriptor.
+
+  @retval EFI_SUCCESS           Success.
+  @retval EFI_INVALID_PARAMETER A parameter is invalid.
+  @retval EFI_NOT_FOUND         The pair is not in the index.
+**/
+EFI_STATUS
+EFIAPI
+CmObjectIndexFind (
+  IN  CONST CM_OBJECT_INDEX           *Index,
+  IN  CONST CM_OBJECT_ID              CmObjectId,
+  IN  CONST CM_OBJECT_TOKEN           Token,
+  OUT       CM_OBJ_DESCRIPTOR * CONST CmObjectDesc
+  );
+
+/** Resolve a token through an object index.
+
+  The index is queried first. On a miss Handler searches the platform
+  repository and the object(s) it finds are recorded in the index, so that
+  repeated queries for the same (ObjectId, Token) pair do not search the
+  platform repository again.
+
+  @param [in]  Index              The object index. If NULL, Handler is
+                                  called for every query.
+  @param [in]  This               Pointer to the Configuration Manager
+                                  Protocol, passed to Handler.
+  @param [in]  CmObjectId         The Configuration Manager Object ID.
+  @param [in]  Token              A token identifying the object(s).
+  @param [in]  Handler            The platform handler searching the object(s)
+                                  referenced by the token.
+  @param [in, out]  CmObjectDesc  Pointer to the Configuration Manager Object
+                                  descriptor describing the requested Object.
+
+  @retval EFI_SUCCESS           Success.
+  @retval EFI_INVALID_PARAMETER A parameter is invalid.
+  @retval EFI_NOT_FOUND         The required object information is not found.
+**/
+EFI_STATUS
+EFIAPI
+CmObjectIndexResolve (
+  IN        CM_OBJECT_INDEX                       *       Index,
+  IN  CONST EDKII_CONFIGURATION_MANAGER_PROTOCOL  * CONST This,
+  IN  CONST CM_OBJECT_ID                                  CmObjectId,
+  IN  CONST CM_OBJECT_TOKEN                               Token,
+  IN  CONST CM_OBJECT_INDEX_HANDLER                       Handler,
+  IN  OUT   CM_OBJ_DESCRIPTOR                     * CONST CmObjectDesc
+  );
+
+#endif // CM_OBJECT_INDEX_LIB_H_
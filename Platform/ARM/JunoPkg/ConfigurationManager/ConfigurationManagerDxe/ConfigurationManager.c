@@ -20,6 +20,7 @@
 #include <Library/ArmLib.h>
 #include <Library/ArmFfaLib.h>
 #include <Library/BaseMemoryLib.h>
+#include <Library/CmObjectIndexLib.h>
 #include <Library/DebugLib.h>
 #include <Library/DynamicTablesScmiInfoLib.h>
 #include <Library/IoLib.h>
@@ -867,7 +868,14 @@ HandleCmObjectRefByToken (
     CmObjectDesc->Count = ObjectCount;
     Status = EFI_SUCCESS;
   } else {
-    Status = HandlerProc (This, CmObjectId, Token, CmObjectDesc);
+    Status = CmObjectIndexResolve (
+               This->PlatRepoInfo->ObjectIndex,
+               This,
+               CmObjectId,
+               Token,
+               HandlerProc,
+               CmObjectDesc
+               );
   }
 
   DEBUG ((
@@ -920,7 +928,14 @@ HandleCmObjectSearchPlatformRepo (
     return EFI_INVALID_PARAMETER;
   }
 
-  Status = HandlerProc (This, CmObjectId, Token, CmObjectDesc);
+  Status = CmObjectIndexResolve (
+             This->PlatRepoInfo->ObjectIndex,
+             This,
+             CmObjectId,
+             Token,
+             HandlerProc,
+             CmObjectDesc
+             );
   DEBUG ((
     DEBUG_INFO,
     "INFO: Token = 0x%p, CmObjectId = %x, Ptr = 0x%p, Size = %d, Count = %d\n",
@@ -1312,12 +1327,25 @@ InitializePlatformRepository (
 
 #ifdef ENABLE_TPM
   Status = PopulatePlatformTpmInfo (PlatformRepo);
-#else
-  Status = EFI_SUCCESS;
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
 #endif
 
+  Status = CmObjectIndexCreate (
+             CM_OBJECT_INDEX_DEFAULT_MAX_ENTRIES,
+             &PlatformRepo->ObjectIndex
+             );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((
+      DEBUG_WARN,
+      "WARNING: Failed to create the object index. Status = %r\n",
+      Status
+      ));
+    PlatformRepo->ObjectIndex = NULL;
+  }
 
-  return Status;
+  return EFI_SUCCESS;
 }
 
 /** Return a GT Block timer frame info list.
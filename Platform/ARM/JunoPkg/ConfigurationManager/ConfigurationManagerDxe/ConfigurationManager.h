@@ -331,6 +331,9 @@ typedef struct PlatformRepositoryInfo {
 
   /// Juno Board Revision
   UINT32                                JunoRevision;
+
+  /// Index of the objects resolved by token
+  CM_OBJECT_INDEX                       *ObjectIndex;
 } EDKII_PLATFORM_REPOSITORY_INFO;
 
 #endif // CONFIGURATION_MANAGER_H__
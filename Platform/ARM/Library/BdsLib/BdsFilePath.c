@@ -9,6 +9,7 @@
 #include "BdsInternal.h"
 
 #include <Library/NetLib.h>
+#include <Library/TimerLib.h>
 
 #include <Protocol/Bds.h>
 #include <Protocol/UsbIo.h>
@@ -23,6 +24,16 @@
 
 #define MAX_TFTP_FILE_SIZE    0x01000000
 
+//
+// TFTP options requested for the download (RFC 2347/2348/2349/7440).
+// 1468 bytes of data fill a standard 1500 bytes Ethernet MTU once the IP,
+// UDP and TFTP headers are added. Servers which do not support the options
+// fall back to 512 bytes blocks acknowledged one by one.
+//
+#define TFTP_DEFAULT_BLKSIZE   512
+#define TFTP_OPTION_BLKSIZE    "1468"
+#define TFTP_OPTION_WINDOWSIZE "16"
+
 /* Type and defines to set up the DHCP4 options */
 
 typedef struct {
@@ -912,6 +923,26 @@ Mtftp4CheckPacket (
   UINTN             Step;
   UINT64            LastNbOf50Kb;
   UINT64            NbOf50Kb;
+  UINT32            OptCnt;
+  EFI_MTFTP4_OPTION *TableOfOptions;
+
+  if ((NTOHS (Packet->OpCode)) == EFI_MTFTP4_OPCODE_OACK) {
+    //
+    // Record the options the server agreed on to report them at the end of
+    // the download. The MTFTP4 driver applies them on its own.
+    //
+    Context = (BDS_TFTP_CONTEXT*)Token->Context;
+    if (!EFI_ERROR (This->ParseOptions (This, PacketLen, Packet, &OptCnt, &TableOfOptions))) {
+      for (Index = 0; Index < OptCnt; Index++) {
+        if (AsciiStriCmp ((CHAR8 *)TableOfOptions[Index].OptionStr, "blksize") == 0) {
+          Context->BlockSize = AsciiStrDecimalToUintn ((CHAR8 *)TableOfOptions[Index].ValueStr);
+        } else if (AsciiStriCmp ((CHAR8 *)TableOfOptions[Index].OptionStr, "windowsize") == 0) {
+          Context->WindowSize = AsciiStrDecimalToUintn ((CHAR8 *)TableOfOptions[Index].ValueStr);
+        }
+      }
+      FreePool (TableOfOptions);
+    }
+  }
 
   if ((NTOHS (Packet->OpCode)) == EFI_MTFTP4_OPCODE_DATA) {
     Context = (BDS_TFTP_CONTEXT*)Token->Context;
@@ -1019,6 +1050,10 @@ BdsTftpLoadImage (
   UINT64                   TftpBufferSize;
   BDS_TFTP_CONTEXT         *TftpContext;
   UINTN                    PathNameLen;
+  EFI_MTFTP4_OPTION        ReqOpt[2];
+  BOOLEAN                  UseOptions;
+  UINT64                   StartTime;
+  UINT64                   ElapsedMs;
 
   ASSERT(IS_DEVICE_PATH_NODE (RemainingDevicePath, MESSAGING_DEVICE_PATH, MSG_IPv4_DP));
   IPv4DevicePathNode = (IPv4_DEVICE_PATH*)RemainingDevicePath;
@@ -1184,6 +1219,17 @@ BdsTftpLoadImage (
   }
   TftpContext->FileSize = FileSize;
 
+  //
+  // Ask for larger blocks and a window of blocks per acknowledgment. If the
+  // server or the MTFTP4 driver refuses them, the download is retried with
+  // plain TFTP.
+  //
+  ReqOpt[0].OptionStr = (UINT8*)"blksize";
+  ReqOpt[0].ValueStr  = (UINT8*)TFTP_OPTION_BLKSIZE;
+  ReqOpt[1].OptionStr = (UINT8*)"windowsize";
+  ReqOpt[1].ValueStr  = (UINT8*)TFTP_OPTION_WINDOWSIZE;
+  UseOptions          = TRUE;
+
   for (; TftpBufferSize <= MAX_TFTP_FILE_SIZE;
          TftpBufferSize = (TftpBufferSize + SIZE_16MB) & (~(SIZE_16MB-1))) {
     //
@@ -1200,19 +1246,37 @@ BdsTftpLoadImage (
       goto Error;
     }
 
-    TftpContext->DownloadedNbOfBytes   = 0;
-    TftpContext->LastReportedNbOfBytes = 0;
+    do {
+      TftpContext->DownloadedNbOfBytes   = 0;
+      TftpContext->LastReportedNbOfBytes = 0;
+      TftpContext->BlockSize             = TFTP_DEFAULT_BLKSIZE;
+      TftpContext->WindowSize            = 1;
+
+      ZeroMem (&Mtftp4Token, sizeof (EFI_MTFTP4_TOKEN));
+      Mtftp4Token.Filename    = (UINT8*)AsciiFilePath;
+      Mtftp4Token.BufferSize  = TftpBufferSize;
+      Mtftp4Token.Buffer      = (VOID *)(UINTN)*Image;
+      Mtftp4Token.CheckPacket = Mtftp4CheckPacket;
+      Mtftp4Token.Context     = (VOID*)TftpContext;
+      if (UseOptions) {
+        Mtftp4Token.OptionCount = ARRAY_SIZE (ReqOpt);
+        Mtftp4Token.OptionList  = ReqOpt;
+      }
 
-    ZeroMem (&Mtftp4Token, sizeof (EFI_MTFTP4_TOKEN));
-    Mtftp4Token.Filename    = (UINT8*)AsciiFilePath;
-    Mtftp4Token.BufferSize  = TftpBufferSize;
-    Mtftp4Token.Buffer      = (VOID *)(UINTN)*Image;
-    Mtftp4Token.CheckPacket = Mtftp4CheckPacket;
-    Mtftp4Token.Context     = (VOID*)TftpContext;
+      Print (L"Downloading the file <%a> from the TFTP server\n", AsciiFilePath);
+      StartTime = GetTimeInNanoSecond (GetPerformanceCounter ());
+      Status    = Mtftp4->ReadFile (Mtftp4, &Mtftp4Token);
+      ElapsedMs = DivU64x32 (GetTimeInNanoSecond (GetPerformanceCounter ()) - StartTime, 1000000);
+      Print (L"\n");
+
+      if (!EFI_ERROR (Status) || (Status == EFI_BUFFER_TOO_SMALL) || !UseOptions) {
+        break;
+      }
+
+      Print (L"TFTP options refused (%r), retrying with default settings.\n", Status);
+      UseOptions = FALSE;
+    } while (TRUE);
 
-    Print (L"Downloading the file <%a> from the TFTP server\n", AsciiFilePath);
-    Status = Mtftp4->ReadFile (Mtftp4, &Mtftp4Token);
-    Print (L"\n");
     if (EFI_ERROR (Status)) {
       gBS->FreePages (*Image, EFI_SIZE_TO_PAGES (TftpBufferSize));
       if (Status == EFI_BUFFER_TOO_SMALL) {
@@ -1224,6 +1288,15 @@ BdsTftpLoadImage (
     }
 
     *ImageSize = Mtftp4Token.BufferSize;
+
+    Print (
+      L"%ld Kb in %ld ms (%ld Kb/s), block size %d, window size %d\n",
+      DivU64x32 (*ImageSize, 1024),
+      ElapsedMs,
+      (ElapsedMs != 0) ? DivU64x64Remainder (MultU64x32 (*ImageSize, 1000), MultU64x32 (ElapsedMs, 1024), NULL) : 0,
+      (UINT32)TftpContext->BlockSize,
+      (UINT32)TftpContext->WindowSize
+      );
     break;
   }
 
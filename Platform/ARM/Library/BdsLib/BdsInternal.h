@@ -91,6 +91,8 @@ typedef struct {
   UINT64  FileSize;
   UINT64  DownloadedNbOfBytes;
   UINT64  LastReportedNbOfBytes;
+  UINTN   BlockSize;   // Block size acknowledged by the server
+  UINTN   WindowSize;  // Window size acknowledged by the server
 } BDS_TFTP_CONTEXT;
 
 /**
@@ -0,0 +1,310 @@
+/** @file
+  Hashed index of Configuration Manager objects.
+
+  The index is an open addressing hash table with linear probing, sized to
+  at least twice the requested number of entries so that probe sequences
+  stay short.
+
+  Copyright (c) 2025, Arm Limited. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/CmObjectIndexLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+
+/** An index slot.
+*/
+typedef struct {
+  /// TRUE if the slot holds an entry.
+  BOOLEAN              InUse;
+
+  /// Token part of the key.
+  CM_OBJECT_TOKEN      Token;
+
+  /// Recorded descriptor. Its ObjectId is the other part of the key.
+  CM_OBJ_DESCRIPTOR    Desc;
+} CM_OBJECT_INDEX_SLOT;
+
+struct CmObjectIndex {
+  /// Number of slots, a power of two.
+  UINTN                   SlotCount;
+
+  /// Number of slots in use.
+  UINTN                   EntryCount;
+
+  /// Maximum number of slots that may be used.
+  UINTN                   MaxEntries;
+
+  /// Slot array.
+  CM_OBJECT_INDEX_SLOT    *Slots;
+};
+
+/** Hash an (ObjectId, Token) pair to a slot index.
+
+  Tokens are usually addresses inside the platform repository, so the low
+  bits carry little information. Fibonacci hashing spreads them over the
+  whole table.
+
+  @param [in]  Index        The object index.
+  @param [in]  CmObjectId   The Configuration Manager Object ID.
+  @param [in]  Token        The token.
+
+  @return The first slot to probe.
+**/
+STATIC
+UINTN
+CmObjectIndexHash (
+  IN  CONST CM_OBJECT_INDEX  *Index,
+  IN  CONST CM_OBJECT_ID     CmObjectId,
+  IN  CONST CM_OBJECT_TOKEN  Token
+  )
+{
+  UINT64  Key;
+
+  Key = ((UINT64)Token ^ LShiftU64 (CmObjectId, 32) ^ CmObjectId);
+  Key = MultU64x64 (Key, 0x9E3779B97F4A7C15ULL);
+
+  return (UINTN)RShiftU64 (Key, 32) & (Index->SlotCount - 1);
+}
+
+/** Find the slot holding an (ObjectId, Token) pair or, failing that, the
+    empty slot where it would be inserted.
+
+  @param [in]  Index        The object index.
+  @param [in]  CmObjectId   The Configuration Manager Object ID.
+  @param [in]  Token        The token.
+
+  @return The slot.
+**/
+STATIC
+CM_OBJECT_INDEX_SLOT *
+CmObjectIndexProbe (
+  IN  CONST CM_OBJECT_INDEX  *Index,
+  IN  CONST CM_OBJECT_ID     CmObjectId,
+  IN  CONST CM_OBJECT_TOKEN  Token
+  )
+{
+  UINTN                 SlotIndex;
+  CM_OBJECT_INDEX_SLOT  *Slot;
+
+  // The load factor is capped at one half, so an empty slot always exists.
+  SlotIndex = CmObjectIndexHash (Index, CmObjectId, Token);
+  while (TRUE) {
+    Slot = &Index->Slots[SlotIndex];
+    if (!Slot->InUse ||
+        ((Slot->Desc.ObjectId == CmObjectId) && (Slot->Token == Token)))
+    {
+      return Slot;
+    }
+
+    SlotIndex = (SlotIndex + 1) & (Index->SlotCount - 1);
+  }
+}
+
+/** Create an empty object index.
+
+  @param [in]  MaxEntries   Maximum number of (ObjectId, Token) pairs the
+                            index must be able to hold.
+  @param [out] Index        Receives the new index.
+
+  @retval EFI_SUCCESS           Success.
+  @retval EFI_INVALID_PARAMETER A parameter is invalid.
+  @retval EFI_OUT_OF_RESOURCES  Memory allocation failed.
+**/
+EFI_STATUS
+EFIAPI
+CmObjectIndexCreate (
+  IN  UINTN            MaxEntries,
+  OUT CM_OBJECT_INDEX  **Index
+  )
+{
+  CM_OBJECT_INDEX  *NewIndex;
+  UINTN            SlotCount;
+
+  if ((MaxEntries == 0) || (MaxEntries > (MAX_UINTN >> 2)) || (Index == NULL)) {
+    ASSERT (MaxEntries != 0);
+    ASSERT (Index != NULL);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  SlotCount = 1;
+  while (SlotCount < (MaxEntries * 2)) {
+    SlotCount <<= 1;
+  }
+
+  NewIndex = AllocateZeroPool (sizeof (CM_OBJECT_INDEX));
+  if (NewIndex == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  NewIndex->Slots = AllocateZeroPool (SlotCount * sizeof (CM_OBJECT_INDEX_SLOT));
+  if (NewIndex->Slots == NULL) {
+    FreePool (NewIndex);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  NewIndex->SlotCount  = SlotCount;
+  NewIndex->MaxEntries = MaxEntries;
+  *Index               = NewIndex;
+
+  return EFI_SUCCESS;
+}
+
+/** Free an object index.
+
+  @param [in]  Index    The index to free. May be NULL.
+**/
+VOID
+EFIAPI
+CmObjectIndexFree (
+  IN  CM_OBJECT_INDEX  *Index
+  )
+{
+  if (Index == NULL) {
+    return;
+  }
+
+  FreePool (Index->Slots);
+  FreePool (Index);
+}
+
+/** Record the object(s) returned for an (ObjectId, Token) pair.
+
+  If the pair is already present its descriptor is replaced.
+
+  @param [in]  Index          The object index.
+  @param [in]  Token          The token the object(s) were requested with.
+  @param [in]  CmObjectDesc   Descriptor of the object(s). The ObjectId field
+                              is part of the key.
+
+  @retval EFI_SUCCESS           Success.
+  @retval EFI_INVALID_PARAMETER A parameter is invalid.
+  @retval EFI_OUT_OF_RESOURCES  The index is full.
+**/
+EFI_STATUS
+EFIAPI
+CmObjectIndexAdd (
+  IN        CM_OBJECT_INDEX           *Index,
+  IN  CONST CM_OBJECT_TOKEN           Token,
+  IN  CONST CM_OBJ_DESCRIPTOR * CONST CmObjectDesc
+  )
+{
+  CM_OBJECT_INDEX_SLOT  *Slot;
+
+  if ((Index == NULL) || (CmObjectDesc == NULL)) {
+    ASSERT (Index != NULL);
+    ASSERT (CmObjectDesc != NULL);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Slot = CmObjectIndexProbe (Index, CmObjectDesc->ObjectId, Token);
+  if (!Slot->InUse) {
+    if (Index->EntryCount == Index->MaxEntries) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Slot->InUse = TRUE;
+    Slot->Token = Token;
+    Index->EntryCount++;
+  }
+
+  CopyMem (&Slot->Desc, CmObjectDesc, sizeof (CM_OBJ_DESCRIPTOR));
+
+  return EFI_SUCCESS;
+}
+
+/** Look up the object(s) recorded for an (ObjectId, Token) pair.
+
+  @param [in]  Index          The object index.
+  @param [in]  CmObjectId     The Configuration Manager Object ID.
+  @param [in]  Token          The token identifying the object(s).
+  @param [out] CmObjectDesc   Receives the recorded descriptor.
+
+  @retval EFI_SUCCESS           Success.
+  @retval EFI_INVALID_PARAMETER A parameter is invalid.
+  @retval EFI_NOT_FOUND         The pair is not in the index.
+**/
+EFI_STATUS
+EFIAPI
+CmObjectIndexFind (
+  IN  CONST CM_OBJECT_INDEX           *Index,
+  IN  CONST CM_OBJECT_ID              CmObjectId,
+  IN  CONST CM_OBJECT_TOKEN           Token,
+  OUT       CM_OBJ_DESCRIPTOR * CONST CmObjectDesc
+  )
+{
+  CONST CM_OBJECT_INDEX_SLOT  *Slot;
+
+  if ((Index == NULL) || (CmObjectDesc == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Slot = CmObjectIndexProbe (Index, CmObjectId, Token);
+  if (!Slot->InUse) {
+    return EFI_NOT_FOUND;
+  }
+
+  CopyMem (CmObjectDesc, &Slot->Desc, sizeof (CM_OBJ_DESCRIPTOR));
+
+  return EFI_SUCCESS;
+}
+
+/** Resolve a token through an object index.
+
+  The index is queried first. On a miss Handler searches the platform
+  repository and the object(s) it finds are recorded in the index, so that
+  repeated queries for the same (ObjectId, Token) pair do not search the
+  platform repository again.
+
+  @param [in]  Index              The object index. If NULL, Handler is
+                                  called for every query.
+  @param [in]  This               Pointer to the Configuration Manager
+                                  Protocol, passed to Handler.
+  @param [in]  CmObjectId         The Configuration Manager Object ID.
+  @param [in]  Token              A token identifying the object(s).
+  @param [in]  Handler            The platform handler searching the object(s)
+                                  referenced by the token.
+  @param [in, out]  CmObjectDesc  Pointer to the Configuration Manager Object
+                                  descriptor describing the requested Object.
+
+  @retval EFI_SUCCESS           Success.
+  @retval EFI_INVALID_PARAMETER A parameter is invalid.
+  @retval EFI_NOT_FOUND         The required object information is not found.
+**/
+EFI_STATUS
+EFIAPI
+CmObjectIndexResolve (
+  IN        CM_OBJECT_INDEX                       *       Index,
+  IN  CONST EDKII_CONFIGURATION_MANAGER_PROTOCOL  * CONST This,
+  IN  CONST CM_OBJECT_ID                                  CmObjectId,
+  IN  CONST CM_OBJECT_TOKEN                               Token,
+  IN  CONST CM_OBJECT_INDEX_HANDLER                       Handler,
+  IN  OUT   CM_OBJ_DESCRIPTOR                     * CONST CmObjectDesc
+  )
+{
+  EFI_STATUS  Status;
+
+  if ((Handler == NULL) || (CmObjectDesc == NULL)) {
+    ASSERT (Handler != NULL);
+    ASSERT (CmObjectDesc != NULL);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if ((Index != NULL) &&
+      !EFI_ERROR (CmObjectIndexFind (Index, CmObjectId, Token, CmObjectDesc)))
+  {
+    return EFI_SUCCESS;
+  }
+
+  Status = Handler (This, CmObjectId, Token, CmObjectDesc);
+  if (!EFI_ERROR (Status) && (Index != NULL)) {
+    CmObjectDesc->ObjectId = CmObjectId;
+    CmObjectIndexAdd (Index, Token, CmObjectDesc);
+  }
+
+  return Status;
+}
@@ -33,7 +33,7 @@
 
 **/
 #define GET_EXTRA_BLOCK_ALIGN(TotalSize, BlockSize) \
-  (BlockSize - (TotalSize % BlockSize))
+  ((BlockSize - (TotalSize % BlockSize)) % BlockSize)
 
 /**
   Retrieve the GPT partition header.
@@ -235,23 +235,25 @@ GptWritePartition (
     return Status;
   }
 
-  // read from flash
-  Status = Instance->ReadBlocks (
-                       Instance,
-                       Media->MediaId,
-                       Lba,
-                       AuxBufferSize,
-                       AuxBuffer
-                       );
-  if (EFI_ERROR (Status)) {
-    DEBUG ((
-      DEBUG_ERROR,
-      "GptWritePartition: Flash read failed Lba %x writeSize %x\n",
-      Lba,
-      AuxBufferSize
-      ));
-
-    goto ErrorHandler;
+  // read from flash, unless the write covers whole device blocks.
+  if ((DeviceBlockOffset != 0) || (WriteAlignment != 0)) {
+    Status = Instance->ReadBlocks (
+                         Instance,
+                         Media->MediaId,
+                         Lba,
+                         AuxBufferSize,
+                         AuxBuffer
+                         );
+    if (EFI_ERROR (Status)) {
+      DEBUG ((
+        DEBUG_ERROR,
+        "GptWritePartition: Flash read failed Lba %x writeSize %x\n",
+        Lba,
+        AuxBufferSize
+        ));
+
+      goto ErrorHandler;
+    }
   }
 
   // Apply the changes to the aux buffer, commit these to flash.
@@ -40,6 +40,14 @@
 
 #define INTERNAL_BUFFER_SIZE  SIZE_1MB
 
+/**
+  Size of the per image file staging buffer used by FwsWrite.
+  fwu_write_stream delivers the image in small chunks bounded by the
+  communication buffer; they are accumulated here and only flushed to the
+  device as whole, device aligned chunks of this size.
+**/
+#define FWS_STAGING_BUFFER_SIZE  SIZE_64KB
+
 #define IMG_DIR_VER  2
 
 /**
@@ -101,6 +109,24 @@ typedef struct {
 
   /// Flags, See the FWS_IFD_F_*
   UINTN      Flags;
+
+  /// Staging buffer for stream writes. NULL until the first FwsWrite.
+  UINT8      *Staging;
+
+  /// Size of Staging in bytes, a multiple of the device block size.
+  UINTN      StagingSize;
+
+  /// Partition offset of the first byte held in Staging.
+  UINTN      StagingOffset;
+
+  /// Number of valid bytes in Staging.
+  UINTN      StagingLength;
+
+  /// Number of bytes passed to FwsWrite.
+  UINT64     BytesWritten;
+
+  /// Number of writes issued to the device.
+  UINT64     DeviceWrites;
 } FWS_IMAGE_FILE_DATA;
 
 STATIC CONST CHAR16  *BankPartitionName[FWU_NUMBER_OF_BANKS] = {
@@ -377,10 +403,82 @@ InternalFwsRelease (
   )
 {
   if (FileData != NULL) {
+    if (FileData->Staging != NULL) {
+      FreePool (FileData->Staging);
+    }
+
     FreePool (FileData);
   }
 }
 
+/**
+  Write back the data accumulated in the staging buffer of an image file.
+
+  @param [in]  FwsDeviceData     FwsDevice's opened data.
+  @param [in]  FileData          FileData generated by InternalFwsOpen.
+
+  @retval EFI_SUCCESS            Staging buffer is empty.
+  @retval Others                 Fail to write the data to partition.
+
+**/
+STATIC
+EFI_STATUS
+InternalFwsFlushStaging (
+  IN FWS_DEVICE_DATA      *FwsDeviceData,
+  IN FWS_IMAGE_FILE_DATA  *FileData
+  )
+{
+  EFI_STATUS  Status;
+
+  if (FileData->StagingLength == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Status = GptWritePartition (
+             FwsDeviceData->GptHandle,
+             FileData->Staging,
+             FileData->StagingLength,
+             FileData->StagingOffset,
+             FileData->StartLba
+             );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to write partition: %r\n", __func__, Status));
+    return Status;
+  }
+
+  FileData->DeviceWrites++;
+  FileData->StagingOffset += FileData->StagingLength;
+  FileData->StagingLength  = 0;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Get the number of bytes from Offset up to the next staging chunk boundary.
+  The boundary is computed on the device address so that every full chunk
+  flushed from the staging buffer covers whole device blocks.
+
+  @param [in]  FileData          FileData generated by InternalFwsOpen.
+  @param [in]  Offset            Offset within the partition.
+
+  @retval      Number of bytes up to the next boundary.
+
+**/
+STATIC
+UINTN
+InternalFwsStagingRoom (
+  IN FWS_IMAGE_FILE_DATA  *FileData,
+  IN UINTN                Offset
+  )
+{
+  UINT64  DeviceOffset;
+
+  DeviceOffset = MultU64x32 (FileData->StartLba, GPT_PARTITION_LBA_SIZE) + Offset;
+
+  return FileData->StagingSize -
+         (UINTN)ModU64x32 (DeviceOffset, (UINT32)FileData->StagingSize);
+}
+
 /**
   Rollback the Image from specified bank.
 
@@ -882,6 +980,7 @@ FwsRelease (
   OUT    UINT32          *TotalWork
   )
 {
+  EFI_STATUS           Status;
   FWS_IMAGE_FILE_DATA  *FileData;
   FWS_DEVICE_DATA      *FwsDeviceData;
 
@@ -895,6 +994,28 @@ FwsRelease (
   FileData      = ImageFile->Private;
   FwsDeviceData = ImageFile->FwsDevice->Private;
 
+  /**
+   * Drain whatever is left in the staging buffer, unless the caller is
+   * throwing the image away (cancel staging rolls the bank back anyway).
+   */
+  if ((ImageFile->Flags & FWS_IF_F_IGNORE_DIRTY) == 0) {
+    Status = InternalFwsFlushStaging (FwsDeviceData, FileData);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  if (FileData->BytesWritten != 0) {
+    DEBUG ((
+      DEBUG_INFO,
+      "%a: %g: %Lu bytes staged, %Lu device writes\n",
+      __func__,
+      &ImageFile->ImageTypeGuid,
+      FileData->BytesWritten,
+      FileData->DeviceWrites
+      ));
+  }
+
   /**
    * Currently, UpdateCapsule is blocking call in UEFI.
    * So we wouldn't use MaxAtomicTimeNs for yield parameter.
@@ -955,6 +1076,11 @@ FwsRead (
   FileData      = ImageFile->Private;
   FwsDeviceData = ImageFile->FwsDevice->Private;
 
+  Status = InternalFwsFlushStaging (FwsDeviceData, FileData);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
   if (Offset + *ReadSize > ImageFile->FileSize) {
     *ReadSize = ImageFile->FileSize - Offset;
   }
@@ -977,6 +1103,10 @@ FwsRead (
 /**
   Write data to a partition stored in the Instance.
 
+  Data is accumulated in a staging buffer and only written to the device
+  in whole, block aligned chunks. The remainder is written back when the
+  image file is read or released.
+
   @param[in]     ImageFile   Image File Handle.
   @param[in]     Buffer      Data to be written to the partition.
   @param[in,out] WriteSize   Size to write / real write to the partition in bytes.
@@ -1000,6 +1130,11 @@ FwsWrite (
   EFI_STATUS           Status;
   FWS_IMAGE_FILE_DATA  *FileData;
   FWS_DEVICE_DATA      *FwsDeviceData;
+  EFI_BLOCK_IO_MEDIA   *Media;
+  UINT8                *Src;
+  UINTN                Remaining;
+  UINTN                Room;
+  UINTN                Chunk;
 
   if ((ImageFile == NULL) ||
       (Buffer == NULL) ||
@@ -1068,18 +1203,78 @@ FwsWrite (
     FileData->Flags |= FWS_IFD_F_DIRTY;
   }
 
-  Status = GptWritePartition (
-             FwsDeviceData->GptHandle,
-             Buffer,
-             *WriteSize,
-             Offset,
-             FileData->StartLba
-             );
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "%a: Failed to write partition: %d\n", __func__, Status));
-    return Status;
+  if (FileData->Staging == NULL) {
+    Media                 = FwsDeviceData->GptHandle->Instance->Media;
+    FileData->StagingSize = MAX (
+                              FWS_STAGING_BUFFER_SIZE - (FWS_STAGING_BUFFER_SIZE % Media->BlockSize),
+                              Media->BlockSize
+                              );
+    FileData->Staging = AllocateRuntimePool (FileData->StagingSize);
+    if (FileData->Staging == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    FileData->StagingOffset = Offset;
+    FileData->StagingLength = 0;
   }
 
+  Src       = Buffer;
+  Remaining = *WriteSize;
+
+  while (Remaining > 0) {
+    // A write which doesn't continue the staged data starts a new chunk.
+    if ((FileData->StagingOffset + FileData->StagingLength) != Offset) {
+      Status = InternalFwsFlushStaging (FwsDeviceData, FileData);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      FileData->StagingOffset = Offset;
+    }
+
+    Room = InternalFwsStagingRoom (FileData, FileData->StagingOffset) -
+           FileData->StagingLength;
+
+    // Whole aligned chunks bypass the staging buffer.
+    if ((FileData->StagingLength == 0) &&
+        (Room == FileData->StagingSize) &&
+        (Remaining >= FileData->StagingSize))
+    {
+      Chunk  = Remaining - (Remaining % FileData->StagingSize);
+      Status = GptWritePartition (
+                 FwsDeviceData->GptHandle,
+                 Src,
+                 Chunk,
+                 Offset,
+                 FileData->StartLba
+                 );
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: Failed to write partition: %r\n", __func__, Status));
+        return Status;
+      }
+
+      FileData->DeviceWrites++;
+      FileData->StagingOffset = Offset + Chunk;
+    } else {
+      Chunk = MIN (Remaining, Room);
+      CopyMem (FileData->Staging + FileData->StagingLength, Src, Chunk);
+      FileData->StagingLength += Chunk;
+
+      if (Chunk == Room) {
+        Status = InternalFwsFlushStaging (FwsDeviceData, FileData);
+        if (EFI_ERROR (Status)) {
+          return Status;
+        }
+      }
+    }
+
+    Src       += Chunk;
+    Offset    += Chunk;
+    Remaining -= Chunk;
+  }
+
+  FileData->BytesWritten += *WriteSize;
+
   return EFI_SUCCESS;
 }
 
@@ -1122,6 +1317,9 @@ FwsErase (
   FileData      = ImageFile->Private;
   FwsDeviceData = ImageFile->FwsDevice->Private;
 
+  // Staged data would be overwritten by the erase below.
+  FileData->StagingLength = 0;
+
   /**
    * There would be better way based on device.
    * But In this implementation, Write data with 0x00 to erase.
@@ -337,7 +337,7 @@ NorFlashEnableWrite (
 {
   UINT32  val;
 
-  DEBUG ((DEBUG_INFO, "NorFlashEnableWrite()\n"));
+  DEBUG ((DEBUG_VERBOSE, "NorFlashEnableWrite()\n"));
   val = (SPINOR_OP_WREN << CDNS_QSPI_FLASH_CMD_CTRL_REG_OPCODE_BIT_POS);
   if (EFI_ERROR (CdnsQspiExecuteCommand (Instance, val))) {
     return EFI_DEVICE_ERROR;
@@ -465,7 +465,7 @@ NorFlashWriteSingleWord (
   )
 {
   DEBUG ((
-    DEBUG_INFO,
+    DEBUG_VERBOSE,
     "NorFlashWriteSingleWord(WordAddress=0x%08x, WriteData=0x%08x)\n",
     WordAddress,
     WriteData
@@ -486,6 +486,10 @@ NorFlashWriteSingleWord (
 /**
   Write a full block to given location.
 
+  The block is only erased when some bit has to go from 0 to 1, and only the
+  words that differ from the current flash contents are programmed. A block
+  that already holds the data is left untouched.
+
   @param[in]    Instance           NOR flash Instance of variable store region.
   @param[in]    Lba                The logical block address in NOR flash.
   @param[in]    DataBuffer         The data to write into NOR flash location.
@@ -506,6 +510,9 @@ NorFlashWriteFullBlock (
   UINTN                   WordAddress;
   UINT32                  WordIndex;
   UINTN                   BlockAddress;
+  UINT32                  FlashWord;
+  BOOLEAN                 DoWrite;
+  BOOLEAN                 DoErase;
   NOR_FLASH_LOCK_CONTEXT  Lock;
 
   Status = EFI_SUCCESS;
@@ -522,20 +529,51 @@ NorFlashWriteFullBlock (
 
   NorFlashLock (&Lock);
 
-  Status = NorFlashUnlockAndEraseSingleBlock (Instance, BlockAddress);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((
-      DEBUG_ERROR,
-      "WriteSingleBlock: ERROR - Failed to Unlock and Erase the single block at 0x%X\n",
-      BlockAddress
-      ));
+  // Programming can only clear bits, so an erase is needed only if a bit of
+  // the new data is set where the flash has it cleared.
+  DoWrite = FALSE;
+  DoErase = FALSE;
+  for (WordIndex = 0; WordIndex < BlockSizeInWords; WordIndex++) {
+    FlashWord = MmioRead32 (BlockAddress + (WordIndex * 4));
+    if (FlashWord != DataBuffer[WordIndex]) {
+      DoWrite = TRUE;
+      if ((FlashWord & DataBuffer[WordIndex]) != DataBuffer[WordIndex]) {
+        DoErase = TRUE;
+        break;
+      }
+    }
+  }
+
+  if (!DoWrite) {
     goto EXIT;
   }
 
+  if (DoErase) {
+    Status = NorFlashUnlockAndEraseSingleBlock (Instance, BlockAddress);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((
+        DEBUG_ERROR,
+        "WriteSingleBlock: ERROR - Failed to Unlock and Erase the single block at 0x%X\n",
+        BlockAddress
+        ));
+      goto EXIT;
+    }
+  } else {
+    Status = NorFlashUnlockSingleBlockIfNecessary (Instance, BlockAddress);
+    if (EFI_ERROR (Status)) {
+      goto EXIT;
+    }
+  }
+
   for (WordIndex = 0;
        WordIndex < BlockSizeInWords;
        WordIndex++, DataBuffer++, WordAddress += 4)
   {
+    // Words already holding the data, erased ones included, need no program
+    if (MmioRead32 (WordAddress) == *DataBuffer) {
+      continue;
+    }
+
     Status = NorFlashWriteSingleWord (Instance, WordAddress, *DataBuffer);
     if (EFI_ERROR (Status)) {
       goto EXIT;
@@ -1002,6 +1040,11 @@ NorFlashWriteSingleBlock (
         PrevBlockAddress = BlockAddress;
       }
 
+      // Nothing to program if the word already holds the data
+      if (WordToWrite == Tmp) {
+        continue;
+      }
+
       Status = NorFlashWriteSingleWord (Instance, WordAddr, WordToWrite);
       if (EFI_ERROR (Status)) {
         return EFI_DEVICE_ERROR;
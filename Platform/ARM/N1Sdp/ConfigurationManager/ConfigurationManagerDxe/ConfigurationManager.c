@@ -15,6 +15,7 @@
 #include <IndustryStandard/MemoryMappedConfigurationSpaceAccessTable.h>
 #include <IndustryStandard/SerialPortConsoleRedirectionTable.h>
 #include <Library/ArmLib.h>
+#include <Library/CmObjectIndexLib.h>
 #include <Library/DebugLib.h>
 #include <Library/HobLib.h>
 #include <Library/IoLib.h>
@@ -1331,7 +1332,14 @@ HandleCmObjectRefByToken (
     CmObjectDesc->Count = ObjectCount;
     Status = EFI_SUCCESS;
   } else {
-    Status = HandlerProc (This, CmObjectId, Token, CmObjectDesc);
+    Status = CmObjectIndexResolve (
+               This->PlatRepoInfo->ObjectIndex,
+               This,
+               CmObjectId,
+               Token,
+               HandlerProc,
+               CmObjectDesc
+               );
   }
 
   DEBUG ((
@@ -1382,7 +1390,14 @@ HandleCmObjectSearchPlatformRepo (
     return EFI_INVALID_PARAMETER;
   }
 
-  Status = HandlerProc (This, CmObjectId, Token, CmObjectDesc);
+  Status = CmObjectIndexResolve (
+             This->PlatRepoInfo->ObjectIndex,
+             This,
+             CmObjectId,
+             Token,
+             HandlerProc,
+             CmObjectDesc
+             );
   DEBUG ((
     DEBUG_INFO,
     "INFO: Token = 0x%p, CmObjectId = %x, Ptr = 0x%p, Size = %d, Count = %d\n",
@@ -1406,6 +1421,7 @@ InitializePlatformRepository (
   IN  EDKII_PLATFORM_REPOSITORY_INFO  * CONST PlatRepoInfo
   )
 {
+  EFI_STATUS                    Status;
   UINT64                        Dram2Size;
   UINT64                        RemoteDdrSize;
   VOID                          *PlatInfoHob;
@@ -1450,6 +1466,19 @@ InitializePlatformRepository (
       Flags = EFI_ACPI_6_3_MEMORY_ENABLED;
   }
 
+  Status = CmObjectIndexCreate (
+             CM_OBJECT_INDEX_DEFAULT_MAX_ENTRIES,
+             &PlatRepoInfo->ObjectIndex
+             );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((
+      DEBUG_WARN,
+      "WARNING: Failed to create the object index. Status = %r\n",
+      Status
+      ));
+    PlatRepoInfo->ObjectIndex = NULL;
+  }
+
   return EFI_SUCCESS;
 }
 
@@ -400,6 +400,8 @@ typedef struct PlatformRepositoryInfo {
   /// N1Sdp Platform Info
   NEOVERSEN1SOC_PLAT_INFO               *PlatInfo;
 
+  /// Index of the objects resolved by token
+  CM_OBJECT_INDEX                       *ObjectIndex;
 } EDKII_PLATFORM_REPOSITORY_INFO;
 
 #endif // CONFIGURATION_MANAGER_H_
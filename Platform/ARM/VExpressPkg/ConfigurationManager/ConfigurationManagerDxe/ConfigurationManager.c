@@ -27,6 +27,7 @@
 #include <Library/BaseLib.h>
 #include <Library/ArmFfaLib.h>
 #include <Library/BaseMemoryLib.h>
+#include <Library/CmObjectIndexLib.h>
 #include <Library/DebugLib.h>
 #include <Library/HiiLib.h>
 #include <Library/IoLib.h>
@@ -1059,7 +1060,14 @@ HandleCmObjectRefByToken (
     CmObjectDesc->Count = ObjectCount;
     Status              = EFI_SUCCESS;
   } else {
-    Status = HandlerProc (This, CmObjectId, Token, CmObjectDesc);
+    Status = CmObjectIndexResolve (
+               This->PlatRepoInfo->ObjectIndex,
+               This,
+               CmObjectId,
+               Token,
+               HandlerProc,
+               CmObjectDesc
+               );
   }
 
   DEBUG ((
@@ -1113,7 +1121,14 @@ HandleCmObjectSearchPlatformRepo (
     return EFI_INVALID_PARAMETER;
   }
 
-  Status = HandlerProc (This, CmObjectId, Token, CmObjectDesc);
+  Status = CmObjectIndexResolve (
+             This->PlatRepoInfo->ObjectIndex,
+             This,
+             CmObjectId,
+             Token,
+             HandlerProc,
+             CmObjectDesc
+             );
   DEBUG ((
     DEBUG_INFO,
     "INFO: Token = 0x%p, CmObjectId = %x, Ptr = 0x%p, Size = %d, Count = %d\n",
@@ -1564,11 +1579,25 @@ InitializePlatformRepository (
 
 #ifdef ENABLE_TPM
   Status = PopulatePlatformTpmInfo (PlatformRepo);
-#else
-  Status = EFI_SUCCESS;
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
 #endif
 
-  return Status;
+  Status = CmObjectIndexCreate (
+             CM_OBJECT_INDEX_DEFAULT_MAX_ENTRIES,
+             &PlatformRepo->ObjectIndex
+             );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((
+      DEBUG_WARN,
+      "WARNING: Failed to create the object index. Status = %r\n",
+      Status
+      ));
+    PlatformRepo->ObjectIndex = NULL;
+  }
+
+  return EFI_SUCCESS;
 }
 
 /** Return Lpi State Info.
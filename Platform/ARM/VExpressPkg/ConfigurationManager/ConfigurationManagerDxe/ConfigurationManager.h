@@ -328,6 +328,9 @@ typedef struct PlatformRepositoryInfo {
   /// TPM2 Device Information
   CM_ARCH_COMMON_TPM2_DEVICE_INFO       TpmDevInfo;
 #endif
+
+  /// Index of the objects resolved by token
+  CM_OBJECT_INDEX                       *ObjectIndex;
 } EDKII_PLATFORM_REPOSITORY_INFO;
 
 #endif // CONFIGURATION_MANAGER_H__
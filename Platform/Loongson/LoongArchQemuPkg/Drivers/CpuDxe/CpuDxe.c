@@ -254,12 +254,6 @@ CpuSetMemoryAttributes (
   IN UINT64                    EfiAttributes
   )
 {
-  EFI_STATUS  Status;
-  UINTN       LoongArchAttributes;
-  UINTN       RegionBaseAddress;
-  UINTN       RegionLength;
-  UINTN       RegionLoongArchAttributes;
-
   if ((BaseAddress & (SIZE_4KB - 1)) != 0) {
     // Minimum granularity is SIZE_4KB (4KB on ARM)
     DEBUG ((DEBUG_PAGE, "CpuSetMemoryAttributes(%lx, %lx, %lx): Minimum granularity is SIZE_4KB\n",
@@ -269,23 +263,13 @@ CpuSetMemoryAttributes (
 
     return EFI_UNSUPPORTED;
   }
-  // Convert the 'Attribute' into LoongArch Attribute
-  LoongArchAttributes = EfiAttributeToLoongArchAttribute (EfiAttributes);
-
-  // Get the region starting from 'BaseAddress' and its 'Attribute'
-  RegionBaseAddress = BaseAddress;
-  Status = GetLoongArchMemoryRegion (RegionBaseAddress, BaseAddress + Length,
-             &RegionLength, &RegionLoongArchAttributes);
-
-  LoongArchSetMemoryAttributes (BaseAddress, Length, EfiAttributes);
-  // Data & Instruction Caches are flushed when we set new memory attributes.
-  // So, we only set the attributes if the new region is different.
-  if (EFI_ERROR (Status) || (RegionLoongArchAttributes != LoongArchAttributes) ||
-      ((BaseAddress + Length) > (RegionBaseAddress + RegionLength)))
-  {
-    return LoongArchSetMemoryAttributes (BaseAddress, Length, EfiAttributes);
-  }
-  return EFI_SUCCESS;
+
+  //
+  // Walk the page tables once. Entries that already have the requested
+  // attributes are left alone and do not invalidate the TLB, so there is
+  // no need to look the current attributes of the region up first.
+  //
+  return LoongArchSetMemoryAttributes (BaseAddress, Length, EfiAttributes);
 }
 
 /**
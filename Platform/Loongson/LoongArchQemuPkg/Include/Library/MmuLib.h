@@ -48,6 +48,7 @@ GetLoongArchMemoryRegion (
   @param[in]  Attributes   The Attributes to be set.
 
   @retval  EFI_SUCCESS    The Attributes was set successfully
+  @retval  EFI_OUT_OF_RESOURCES    The page tables could not be allocated
 **/
 EFI_STATUS
 LoongArchSetMemoryAttributes (
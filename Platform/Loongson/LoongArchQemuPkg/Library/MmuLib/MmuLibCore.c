@@ -472,6 +472,29 @@ GetHugePageAttributes (
   return Attributes;
 }
 
+/**
+  Invalidates the TLB entries of the specified memory region.
+
+  @param  Address  The memory space start address.
+  @param  End  The end address of the memory space.
+
+  @retval VOID
+**/
+VOID
+InvalidTlbRange (
+  IN UINTN Address,
+  IN UINTN End
+  )
+{
+  //
+  // Each TLB entry maps an even/odd pair of pages.
+  //
+  Address &= ~(UINTN)(2 * EFI_PAGE_SIZE - 1);
+  for ( ; Address < End; Address += 2 * EFI_PAGE_SIZE) {
+    LoongarchInvalidTlb (Address);
+  }
+}
+
 /**
   Establishes a page table entry based on the specified memory region.
 
@@ -505,18 +528,18 @@ MemoryMapPteRange (
     __func__, __LINE__,  Address, End, Attributes));
 
   do {
-    UpDate = FALSE;
     PteVal = MAKE_PTE (Address, Attributes);
 
-    if ((!pte_none (*Pte)) &&
-        (PTE_VAL(*Pte) != PTE_VAL(PteVal)))
-    {
-      UpDate = TRUE;
-    }
-
-    SetPte (Pte, PteVal);
-    if (UpDate) {
-      LoongarchInvalidTlb(Address);
+    //
+    // Entries that already hold the requested mapping are left alone. Only
+    // a valid entry that changes can be cached in the TLB.
+    //
+    if (PTE_VAL(*Pte) != PTE_VAL(PteVal)) {
+      UpDate = !pte_none (*Pte);
+      SetPte (Pte, PteVal);
+      if (UpDate) {
+        LoongarchInvalidTlb(Address);
+      }
     }
   } while (Pte++, Address += EFI_PAGE_SIZE, Address != End);
 
@@ -547,12 +570,21 @@ ConvertHugePageToPage (
   UINTN HugePageStart;
   EFI_STATUS Status;
 
+  Status = EFI_SUCCESS;
   if ((pmd_none (*Pmd)) ||
       (!IS_HUGE_PAGE (Pmd->PmdVal)))
   {
     Status |= MemoryMapPteRange (Pmd, Address, End, Attributes);
   } else {
     OldAttributes = GetHugePageAttributes(Pmd);
+    if (OldAttributes == Attributes) {
+      //
+      // The huge page already has the requested Attributes, splitting it
+      // would only be undone by MergePteTable.
+      //
+      return EFI_SUCCESS;
+    }
+
     SetPmd (Pmd, (PTE *)PcdGet64 (PcdInvalidPte));
     HugePageStart = Address & PMD_MASK;
     HugePageEnd = HugePageStart + HUGE_PAGE_SIZE;
@@ -567,11 +599,87 @@ ConvertHugePageToPage (
     if (End < HugePageEnd) {
       Status |= MemoryMapPteRange (Pmd, End, HugePageEnd, OldAttributes);
     }
+
+    //
+    // The new page table starts out empty, so MemoryMapPteRange never
+    // invalidates anything here. Drop the TLB entries of the old huge page,
+    // otherwise they keep mapping the changed subrange with the old
+    // Attributes.
+    //
+    InvalidTlbRange (HugePageStart, HugePageEnd);
   }
 
   return Status;
 }
 
+/**
+  Merges a page table back into a huge page.
+
+  The page table is merged when its entries map a whole, naturally aligned
+  huge page with the same Attributes. This undoes the split made by
+  ConvertHugePageToPage once the Attributes within the huge page are uniform
+  again, so that the page tables do not stay fragmented.
+
+  @param  Pmd  A pointer to the page middle directory.
+  @param  Address  The start address of the huge page.
+
+  @retval  TRUE   The page table was merged into a huge page.
+  @retval  FALSE  The page table was left unchanged.
+**/
+BOOLEAN
+MergePteTable (
+  IN PMD *Pmd,
+  IN UINTN Address
+  )
+{
+  PTE   *Pte;
+  UINTN PhysicalBase;
+  UINTN Attributes;
+  UINTN Index;
+
+  if ((pmd_none (*Pmd)) ||
+      (IS_HUGE_PAGE (Pmd->PmdVal)))
+  {
+    return FALSE;
+  }
+
+  Pte = (PTE *)PMD_VAL (*Pmd);
+  PhysicalBase = PTE_VAL (Pte[0]) & PFN_MASK;
+  Attributes = GET_PAGE_ATTRIBUTES (Pte[0]);
+
+  //
+  // A huge page entry can only express global mappings, see MAKE_HUGE_PTE.
+  //
+  if (((Attributes & PAGE_VALID) == 0) ||
+      ((Attributes & PAGE_GLOBAL) == 0) ||
+      ((PhysicalBase & (~PMD_MASK)) != 0))
+  {
+    return FALSE;
+  }
+
+  for (Index = 1; Index < ENTRYS_PER_PTE; Index++) {
+    if (PTE_VAL (Pte[Index]) !=
+        PTE_VAL (MAKE_PTE (PhysicalBase + Index * EFI_PAGE_SIZE, Attributes)))
+    {
+      return FALSE;
+    }
+  }
+
+  DEBUG ((DEBUG_VERBOSE,
+    "%a %d Address %p Attributes %llx\n",
+    __func__, __LINE__, Address, Attributes));
+
+  //
+  // The page table is freed only once the huge page is in place, so that the
+  // tables are consistent if freeing it updates memory attributes again.
+  //
+  SetPmd (Pmd, (PTE *)MAKE_HUGE_PTE (PhysicalBase, Attributes));
+  InvalidTlbRange (Address, Address + HUGE_PAGE_SIZE);
+  PteFree (Pte);
+
+  return TRUE;
+}
+
 /**
   Establishes a page middle directory based on the specified memory region.
 
@@ -592,7 +700,9 @@ MemoryMapPmdRange (
   )
 {
   PMD *Pmd;
+  PMD OldPmd;
   UINTN Next;
+  EFI_STATUS Status;
 
   Pmd = PmdAllocGet (Pud, Address);
   if (!Pmd) {
@@ -602,21 +712,37 @@ MemoryMapPmdRange (
   do {
     Next = PMD_ADDRESS_END (Address, End);
     if (((Address & (~PMD_MASK)) == 0) &&
-        ((Next &  (~PMD_MASK)) == 0) &&
-        (pmd_none (*Pmd) || IS_HUGE_PAGE (Pmd->PmdVal)))
+        ((Next &  (~PMD_MASK)) == 0))
     {
       DEBUG ((DEBUG_VERBOSE,
         "%a %d Address %p  PGD_INDEX %p PUD_INDEX   %p PMD_INDEX  %p MAKE_HUGE_PTE  %p\n",
         __func__, __LINE__,  Address, PGD_INDEX (Address), PUD_INDEX (Address), PMD_INDEX (Address),
         MAKE_HUGE_PTE (Address, Attributes)));
 
+      OldPmd = *Pmd;
       SetPmd (Pmd, (PTE *)MAKE_HUGE_PTE (Address, Attributes));
+      if ((!pmd_none (OldPmd)) &&
+          (PMD_VAL (OldPmd) != PMD_VAL (*Pmd)))
+      {
+        InvalidTlbRange (Address, Next);
+        if (!IS_HUGE_PAGE (OldPmd.PmdVal)) {
+          //
+          // The whole page table is covered by the new huge page.
+          //
+          PteFree ((PTE *)PMD_VAL (OldPmd));
+        }
+      }
     } else {
-      ConvertHugePageToPage (Pmd, Address, Next, Attributes);
+      Status = ConvertHugePageToPage (Pmd, Address, Next, Attributes);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      MergePteTable (Pmd, Address & PMD_MASK);
     }
   } while (Pmd++, Address = Next, Address != End);
 
-  return 0;
+  return EFI_SUCCESS;
 }
 
 /**
@@ -827,6 +953,7 @@ GetLoongArchMemoryRegion (
   @param[in]  Attributes   The Attributes to be set.
 
   @retval  EFI_SUCCESS    The Attributes was set successfully
+  @retval  EFI_OUT_OF_RESOURCES    The page tables could not be allocated
 **/
 EFI_STATUS
 LoongArchSetMemoryAttributes (
@@ -835,16 +962,17 @@ LoongArchSetMemoryAttributes (
   IN UINTN                 Attributes
   )
 {
+  EFI_STATUS Status;
 
   if (!MmuIsInit ()) {
     return EFI_SUCCESS;
   }
   Attributes = EfiAttributeToLoongArchAttribute (Attributes);
   DEBUG ((DEBUG_VERBOSE, "%a %d %p %p %p.\n", __func__, __LINE__, BaseAddress , Length, Attributes));
-  MemoryMapPageRange (BaseAddress, BaseAddress + Length, Attributes);
+  Status = MemoryMapPageRange (BaseAddress, BaseAddress + Length, Attributes);
   DEBUG ((DEBUG_VERBOSE, "%a %d end.\n", __func__, __LINE__));
 
-  return EFI_SUCCESS;
+  return Status;
 }
 
 /**
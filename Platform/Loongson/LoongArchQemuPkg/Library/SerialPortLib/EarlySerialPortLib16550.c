@@ -15,6 +15,7 @@
 #include <Library/BaseLib.h>
 #include <Guid/FdtHob.h>
 #include <Library/FdtLib.h>
+#include "EarlySerialPortLib16550.h"
 
 //
 // PCI Defintions.
@@ -191,29 +192,56 @@ GetSerialConsolePortAddress (
 }
 
 /**
-  Retrieve the I/O or MMIO base address register for the PCI UART device.
+  Look up the console UART base address in the DT and cache it in CSR KS1.
 
-  This function assumes Root Bus Numer is Zero, and enables I/O and MMIO in PCI UART
-  Device if they are not already enabled.
+  This library runs in place from flash in SEC and PEI, so there is no writable
+  global to hold the base address. KS1 is not used until CpuDxe installs its
+  exception vectors, by which time the DXE serial port library has taken over.
 
-  @return  The base address register of the UART device.
+  @return  The base address register of the UART device, or 0 if not found.
 **/
+STATIC
 UINTN
-GetSerialRegisterBase (
+RefreshSerialRegisterBase (
   VOID
   )
 {
-  VOID    *Base;
+  VOID           *Base;
   RETURN_STATUS  Status;
-  UINT64  SerialConsoleAddress;
+  UINT64         SerialConsoleAddress;
 
-  Base = (VOID*)(UINTN)PcdGet64 (PcdDeviceTreeBase);
+  Base   = (VOID *)(UINTN)PcdGet64 (PcdDeviceTreeBase);
   Status = GetSerialConsolePortAddress (Base, &SerialConsoleAddress);
-  if (RETURN_ERROR (Status)) {
+  if (RETURN_ERROR (Status) || ((SerialConsoleAddress & ~SERIAL_BASE_CACHE_MASK) != 0)) {
+    LoongarchWriteqKs1 (0);
     return (UINTN)0;
   }
 
-  return SerialConsoleAddress;
+  LoongarchWriteqKs1 ((SERIAL_BASE_CACHE_SIGNATURE << SERIAL_BASE_CACHE_SHIFT) | SerialConsoleAddress);
+  return (UINTN)SerialConsoleAddress;
+}
+
+/**
+  Retrieve the I/O or MMIO base address register for the PCI UART device.
+
+  The DT is only parsed the first time; after that the address cached in CSR KS1
+  is returned, which keeps every SerialPortWrite() from walking the DT.
+
+  @return  The base address register of the UART device.
+**/
+UINTN
+GetSerialRegisterBase (
+  VOID
+  )
+{
+  UINT64  Cache;
+
+  LoongarchReadqKs1 (&Cache);
+  if ((Cache >> SERIAL_BASE_CACHE_SHIFT) == SERIAL_BASE_CACHE_SIGNATURE) {
+    return (UINTN)(Cache & SERIAL_BASE_CACHE_MASK);
+  }
+
+  return RefreshSerialRegisterBase ();
 }
 
 /**
@@ -295,9 +323,10 @@ SerialPortInitialize (
   }
 
   //
-  // Get the base address of the serial port in either I/O or MMIO space
+  // Get the base address of the serial port in either I/O or MMIO space.
+  // Always consult the DT here so a stale KS1 from a warm reset is replaced.
   //
-  SerialRegisterBase = GetSerialRegisterBase ();
+  SerialRegisterBase = RefreshSerialRegisterBase ();
   if (SerialRegisterBase == 0) {
     return RETURN_DEVICE_ERROR;
   }
@@ -437,10 +466,11 @@ SerialPortWrite (
   Result = NumberOfBytes;
   while (NumberOfBytes != 0) {
     //
-    // Wait for the serial port to be ready, to make sure both the transmit FIFO
-    // and shift register empty.
+    // Wait for the transmit FIFO to drain. THRE alone guarantees FifoSize free
+    // slots; waiting for TEMT as well would also stall on the last character
+    // in the shift register and leave the line idle between bursts.
     //
-    while ((SerialPortReadRegister (SerialRegisterBase, R_UART_LSR) & (B_UART_LSR_TEMT | B_UART_LSR_TXRDY)) != (B_UART_LSR_TEMT | B_UART_LSR_TXRDY)) {
+    while ((SerialPortReadRegister (SerialRegisterBase, R_UART_LSR) & B_UART_LSR_TXRDY) == 0) {
     }
 
     //
@@ -0,0 +1,48 @@
+/** @file
+  EarlySerialPortLib16550
+
+  Copyright (c) 2022 Loongson Technology Corporation Limited. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef EARLY_SERIAL_PORT_LIB_16550_H_
+#define EARLY_SERIAL_PORT_LIB_16550_H_
+
+//
+// The console UART base is cached in CSR KS1, which is otherwise unused
+// before CpuDxe installs the exception vectors. The upper 16 bits carry a
+// signature so that a reset value is never mistaken for a valid base.
+//
+#define SERIAL_BASE_CACHE_SIGNATURE  0x5E1AULL
+#define SERIAL_BASE_CACHE_SHIFT      48
+#define SERIAL_BASE_CACHE_MASK       ((1ULL << SERIAL_BASE_CACHE_SHIFT) - 1)
+
+/**
+  Write Csr KS1 register.
+
+ @param Val The value used to write to the KS1 register
+
+  @retval none
+**/
+extern
+VOID
+LoongarchWriteqKs1 (
+  IN UINT64  Val
+  );
+
+/**
+  Read Csr KS1 register.
+
+ @param  Val Pointer to the variable used to store the KS1 register value
+
+  @retval none
+**/
+extern
+VOID
+LoongarchReadqKs1 (
+  IN UINT64  *Val
+  );
+
+#endif // EARLY_SERIAL_PORT_LIB_16550_H_
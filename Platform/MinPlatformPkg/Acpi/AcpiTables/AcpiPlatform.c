@@ -60,6 +60,77 @@ EFI_MP_SERVICES_PROTOCOL    *mMpService;
 UINTN                       mNumberOfCpus = 0;
 UINTN                       mNumberOfEnabledCPUs = 0;
 
+//
+// The MADT and MCFG built from scratch are saved in a variable together with
+// a fingerprint of everything they are built from. As long as the fingerprint
+// matches, later boots install the saved tables instead of rebuilding them,
+// which saves the StartupAllAPs round needed to read the core types.
+// The fingerprint includes the name and length of the firmware volume this
+// driver was loaded from and the firmware revision. That identifies the
+// firmware build cheaply, so that a firmware update drops the cache.
+//
+#define ACPI_TABLE_CACHE_VARIABLE_NAME  L"AcpiPlatformCache"
+#define ACPI_TABLE_CACHE_SIGNATURE      SIGNATURE_32 ('A', 'P', 'T', 'C')
+#define ACPI_TABLE_CACHE_REVISION       3
+
+typedef struct {
+  UINT32   Signature;
+  UINT32   Revision;
+  UINT32   Fingerprint;
+  UINT32   TableCount;
+  UINT64   BuildTimeNs;      // Time it took to build the tables from scratch
+  //
+  // Followed by TableCount ACPI tables
+  //
+} ACPI_TABLE_CACHE_HEADER;
+
+#pragma pack(1)
+
+typedef struct {
+  UINT64                      ProcessorId;
+  UINT32                      StatusFlag;
+  EFI_CPU_PHYSICAL_LOCATION   Location;
+} ACPI_CPU_FINGERPRINT;
+
+typedef struct {
+  EFI_GUID FirmwareVolumeName;
+  UINT64   FirmwareVolumeLength;
+  UINT32   FirmwareRevision;
+  UINT32   CpuidSignature;
+  UINT32   CpuidFeatureFlags;
+  UINT64   NumberOfCpus;
+  UINT64   NumberOfEnabledCpus;
+  UINT8    X2ApicEnabled;
+  UINT32   NumOfBitShift;
+  UINT32   LocalApicAddress;
+  UINT32   IoApicAddress;
+  UINT8    IoApicId;
+  UINT32   PcIoApicEnable;
+  UINT8    PcIoApicCount;
+  UINT8    PcIoApicIdBase;
+  UINT32   PcIoApicAddressBase;
+  UINT8    OemId[6];
+  UINT64   OemTableId;
+  UINT32   OemRevision;
+  UINT32   CreatorId;
+  UINT32   CreatorRevision;
+  UINT64   SegmentCount;
+  //
+  // Followed by NumberOfCpus ACPI_CPU_FINGERPRINT and
+  // SegmentCount PCI_SEGMENT_INFO
+  //
+} ACPI_HARDWARE_FINGERPRINT;
+
+#pragma pack()
+
+//
+// Signatures of the tables saved in the cache.
+//
+STATIC CONST UINT32  mCachedTableSignatures[] = {
+  EFI_ACPI_6_5_MULTIPLE_APIC_DESCRIPTION_TABLE_SIGNATURE,
+  EFI_ACPI_6_5_PCI_EXPRESS_MEMORY_MAPPED_CONFIGURATION_SPACE_BASE_ADDRESS_DESCRIPTION_TABLE_SIGNATURE
+};
+
 /**
   Print Cpu Apic ID Table
 
@@ -1577,6 +1648,305 @@ AcpiEndOfDxeEvent (
   IsAcpiTableChange ();
 }
 
+/**
+  Identify the firmware volume this driver was loaded from.
+
+  Only the volume headers are read: the FvName from the extended header and
+  the volume length. Together with the firmware revision they identify the
+  firmware build without touching the volume contents.
+
+  @param[out] FvName        Name of the firmware volume.
+  @param[out] FvLength      Length of the firmware volume.
+
+  @retval EFI_SUCCESS       The firmware volume was identified.
+  @retval Others            The firmware volume could not be located or has
+                            no extended header.
+**/
+EFI_STATUS
+GetFirmwareVolumeIdentity (
+  OUT EFI_GUID  *FvName,
+  OUT UINT64    *FvLength
+  )
+{
+  EFI_STATUS                          Status;
+  EFI_LOADED_IMAGE_PROTOCOL           *LoadedImage;
+  EFI_FIRMWARE_VOLUME_BLOCK_PROTOCOL  *Fvb;
+  EFI_PHYSICAL_ADDRESS                FvAddress;
+  EFI_FIRMWARE_VOLUME_HEADER          *FvHeader;
+  EFI_FIRMWARE_VOLUME_EXT_HEADER      *FvExtHeader;
+
+  Status = gBS->HandleProtocol (gImageHandle, &gEfiLoadedImageProtocolGuid, (VOID **)&LoadedImage);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = gBS->HandleProtocol (LoadedImage->DeviceHandle, &gEfiFirmwareVolumeBlockProtocolGuid, (VOID **)&Fvb);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = Fvb->GetPhysicalAddress (Fvb, &FvAddress);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  FvHeader = (EFI_FIRMWARE_VOLUME_HEADER *)(UINTN)FvAddress;
+  if ((FvHeader->Signature != EFI_FVH_SIGNATURE) ||
+      (FvHeader->ExtHeaderOffset == 0) ||
+      (FvHeader->ExtHeaderOffset + sizeof (EFI_FIRMWARE_VOLUME_EXT_HEADER) > FvHeader->FvLength)) {
+    return EFI_NOT_FOUND;
+  }
+
+  FvExtHeader = (EFI_FIRMWARE_VOLUME_EXT_HEADER *)((UINT8 *)FvHeader + FvHeader->ExtHeaderOffset);
+  CopyGuid (FvName, &FvExtHeader->FvName);
+  *FvLength = FvHeader->FvLength;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Compute a fingerprint of the configuration the MADT and MCFG are built
+  from: firmware build, CPU topology, PCI segments and the platform PCDs used.
+
+  @param[out] Fingerprint   CRC32 of the hardware configuration.
+
+  @retval EFI_SUCCESS           The fingerprint was computed.
+  @retval EFI_OUT_OF_RESOURCES  Could not allocate the fingerprint buffer.
+  @retval Others                The firmware build could not be identified.
+**/
+EFI_STATUS
+GetAcpiHardwareFingerprint (
+  OUT UINT32  *Fingerprint
+  )
+{
+  EFI_STATUS                 Status;
+  ACPI_HARDWARE_FINGERPRINT  *Header;
+  ACPI_CPU_FINGERPRINT       *Cpu;
+  EFI_PROCESSOR_INFORMATION  ProcessorInfoBuffer;
+  PCI_SEGMENT_INFO           *PciSegmentInfo;
+  UINTN                      SegmentCount;
+  UINTN                      Size;
+  UINTN                      Index;
+
+  PciSegmentInfo = GetPciSegmentInfo (&SegmentCount);
+
+  Size   = sizeof (ACPI_HARDWARE_FINGERPRINT) +
+           mNumberOfCpus * sizeof (ACPI_CPU_FINGERPRINT) +
+           SegmentCount * sizeof (PCI_SEGMENT_INFO);
+  Header = AllocateZeroPool (Size);
+  if (Header == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = GetFirmwareVolumeIdentity (&Header->FirmwareVolumeName, &Header->FirmwareVolumeLength);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "ACPI table cache disabled, firmware volume not identified: %r\n", Status));
+    FreePool (Header);
+    return Status;
+  }
+  Header->FirmwareRevision = gST->FirmwareRevision;
+
+  AsmCpuid (CPUID_VERSION_INFO, &Header->CpuidSignature, NULL, NULL, NULL);
+  AsmCpuidEx (CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS, 0, NULL, NULL, NULL, &Header->CpuidFeatureFlags);
+  Header->NumberOfCpus        = mNumberOfCpus;
+  Header->NumberOfEnabledCpus = mNumberOfEnabledCPUs;
+  Header->X2ApicEnabled       = mX2ApicEnabled;
+  Header->NumOfBitShift       = mNumOfBitShift;
+  Header->LocalApicAddress    = PcdGet32 (PcdLocalApicAddress);
+  Header->IoApicAddress       = PcdGet32 (PcdIoApicAddress);
+  Header->IoApicId            = PcdGet8 (PcdIoApicId);
+  Header->PcIoApicEnable      = PcdGet32 (PcdPcIoApicEnable);
+  Header->PcIoApicCount       = PcdGet8 (PcdPcIoApicCount);
+  Header->PcIoApicIdBase      = PcdGet8 (PcdPcIoApicIdBase);
+  Header->PcIoApicAddressBase = PcdGet32 (PcdPcIoApicAddressBase);
+  CopyMem (Header->OemId, PcdGetPtr (PcdAcpiDefaultOemId), sizeof (Header->OemId));
+  Header->OemTableId          = PcdGet64 (PcdAcpiDefaultOemTableId);
+  Header->OemRevision         = FixedPcdGet32 (PcdAcpiDefaultOemRevision);
+  Header->CreatorId           = PcdGet32 (PcdAcpiDefaultCreatorId);
+  Header->CreatorRevision     = PcdGet32 (PcdAcpiDefaultCreatorRevision);
+  Header->SegmentCount        = SegmentCount;
+
+  Cpu = (ACPI_CPU_FINGERPRINT *)(Header + 1);
+  for (Index = 0; Index < mNumberOfCpus; Index++) {
+    Status = mMpService->GetProcessorInfo (mMpService, Index, &ProcessorInfoBuffer);
+    if (!EFI_ERROR (Status)) {
+      Cpu[Index].ProcessorId = ProcessorInfoBuffer.ProcessorId;
+      Cpu[Index].StatusFlag  = ProcessorInfoBuffer.StatusFlag;
+      CopyMem (&Cpu[Index].Location, &ProcessorInfoBuffer.Location, sizeof (Cpu[Index].Location));
+    }
+  }
+
+  if (SegmentCount != 0) {
+    CopyMem (&Cpu[mNumberOfCpus], PciSegmentInfo, SegmentCount * sizeof (PCI_SEGMENT_INFO));
+  }
+
+  Status = gBS->CalculateCrc32 (Header, Size, Fingerprint);
+  FreePool (Header);
+
+  return Status;
+}
+
+/**
+  Install the MADT and MCFG saved by a previous boot if they were built
+  for the same hardware configuration.
+
+  @param[in] Fingerprint    Fingerprint of the current hardware configuration.
+  @param[in] StartTime      Time stamp in ns taken before the fingerprint was
+                            computed, so the logged cost of the cached path
+                            includes it.
+
+  @retval EFI_SUCCESS       The cached tables were installed.
+  @retval EFI_NOT_FOUND     There is no valid cache for this configuration.
+  @retval Others            Failed to install the cached tables.
+**/
+EFI_STATUS
+InstallCachedTables (
+  IN UINT32  Fingerprint,
+  IN UINT64  StartTime
+  )
+{
+  EFI_STATUS                   Status;
+  ACPI_TABLE_CACHE_HEADER      *Cache;
+  UINTN                        CacheSize;
+  EFI_ACPI_DESCRIPTION_HEADER  *Table;
+  UINTN                        Offset;
+  UINTN                        Index;
+  UINTN                        TableHandle[ARRAY_SIZE (mCachedTableSignatures)];
+  UINT64                       CachedTimeNs;
+
+  Status = GetVariable2 (
+             ACPI_TABLE_CACHE_VARIABLE_NAME,
+             &gEfiCallerIdGuid,
+             (VOID **)&Cache,
+             &CacheSize
+             );
+  if (EFI_ERROR (Status)) {
+    return EFI_NOT_FOUND;
+  }
+
+  if ((CacheSize < sizeof (ACPI_TABLE_CACHE_HEADER)) ||
+      (Cache->Signature != ACPI_TABLE_CACHE_SIGNATURE) ||
+      (Cache->Revision != ACPI_TABLE_CACHE_REVISION) ||
+      (Cache->Fingerprint != Fingerprint) ||
+      (Cache->TableCount != ARRAY_SIZE (mCachedTableSignatures))) {
+    DEBUG ((DEBUG_INFO, "ACPI table cache does not match the hardware configuration\n"));
+    FreePool (Cache);
+    return EFI_NOT_FOUND;
+  }
+
+  //
+  // Validate all the tables before installing any of them.
+  //
+  Offset = sizeof (ACPI_TABLE_CACHE_HEADER);
+  for (Index = 0; Index < Cache->TableCount; Index++) {
+    Table = (EFI_ACPI_DESCRIPTION_HEADER *)((UINT8 *)Cache + Offset);
+    if ((CacheSize - Offset < sizeof (EFI_ACPI_DESCRIPTION_HEADER)) ||
+        (Table->Length < sizeof (EFI_ACPI_DESCRIPTION_HEADER)) ||
+        (CacheSize - Offset < Table->Length) ||
+        (Table->Signature != mCachedTableSignatures[Index])) {
+      DEBUG ((DEBUG_WARN, "ACPI table cache is corrupted\n"));
+      FreePool (Cache);
+      return EFI_NOT_FOUND;
+    }
+    Offset += Table->Length;
+  }
+
+  Offset = sizeof (ACPI_TABLE_CACHE_HEADER);
+  for (Index = 0; Index < Cache->TableCount; Index++) {
+    Table = (EFI_ACPI_DESCRIPTION_HEADER *)((UINT8 *)Cache + Offset);
+    Status = mAcpiTable->InstallAcpiTable (
+                           mAcpiTable,
+                           Table,
+                           Table->Length,
+                           &TableHandle[Index]
+                           );
+    if (EFI_ERROR (Status)) {
+      //
+      // Remove what was installed so far, the caller rebuilds everything.
+      //
+      DEBUG ((DEBUG_ERROR, "Install cached ACPI table failed: %r\n", Status));
+      while (Index-- > 0) {
+        mAcpiTable->UninstallAcpiTable (mAcpiTable, TableHandle[Index]);
+      }
+      break;
+    }
+    Offset += Table->Length;
+  }
+
+  if (!EFI_ERROR (Status)) {
+    CachedTimeNs = GetTimeInNanoSecond (GetPerformanceCounter ()) - StartTime;
+    DEBUG ((
+      DEBUG_INFO,
+      "Installed cached MADT/MCFG in %ld us (fingerprint included), building them took %ld us, %a %ld us\n",
+      DivU64x32 (CachedTimeNs, 1000),
+      DivU64x32 (Cache->BuildTimeNs, 1000),
+      (Cache->BuildTimeNs >= CachedTimeNs) ? "saved" : "lost",
+      DivU64x32 ((Cache->BuildTimeNs >= CachedTimeNs) ? (Cache->BuildTimeNs - CachedTimeNs) : (CachedTimeNs - Cache->BuildTimeNs), 1000)
+      ));
+  }
+
+  FreePool (Cache);
+  return Status;
+}
+
+/**
+  Save the installed MADT and MCFG with the fingerprint of the hardware
+  configuration they were built for.
+
+  @param[in] Fingerprint    Fingerprint of the current hardware configuration.
+  @param[in] BuildTimeNs    Time it took to build the tables.
+**/
+VOID
+SaveTablesToCache (
+  IN UINT32  Fingerprint,
+  IN UINT64  BuildTimeNs
+  )
+{
+  EFI_STATUS                   Status;
+  EFI_ACPI_DESCRIPTION_HEADER  *Tables[ARRAY_SIZE (mCachedTableSignatures)];
+  ACPI_TABLE_CACHE_HEADER      *Cache;
+  UINTN                        CacheSize;
+  UINT8                        *Walker;
+  UINTN                        Index;
+
+  CacheSize = sizeof (ACPI_TABLE_CACHE_HEADER);
+  for (Index = 0; Index < ARRAY_SIZE (mCachedTableSignatures); Index++) {
+    Tables[Index] = (EFI_ACPI_DESCRIPTION_HEADER *)EfiLocateFirstAcpiTable (mCachedTableSignatures[Index]);
+    if (Tables[Index] == NULL) {
+      return;
+    }
+    CacheSize += Tables[Index]->Length;
+  }
+
+  Cache = AllocatePool (CacheSize);
+  if (Cache == NULL) {
+    return;
+  }
+
+  Cache->Signature   = ACPI_TABLE_CACHE_SIGNATURE;
+  Cache->Revision    = ACPI_TABLE_CACHE_REVISION;
+  Cache->Fingerprint = Fingerprint;
+  Cache->TableCount  = ARRAY_SIZE (mCachedTableSignatures);
+  Cache->BuildTimeNs = BuildTimeNs;
+
+  Walker = (UINT8 *)(Cache + 1);
+  for (Index = 0; Index < ARRAY_SIZE (mCachedTableSignatures); Index++) {
+    CopyMem (Walker, Tables[Index], Tables[Index]->Length);
+    Walker += Tables[Index]->Length;
+  }
+
+  Status = gRT->SetVariable (
+                  ACPI_TABLE_CACHE_VARIABLE_NAME,
+                  &gEfiCallerIdGuid,
+                  EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                  CacheSize,
+                  Cache
+                  );
+  DEBUG ((DEBUG_INFO, "Saved ACPI table cache (0x%x bytes): %r\n", CacheSize, Status));
+
+  FreePool (Cache);
+}
+
 /**
   ACPI Platform driver installation function.
 
@@ -1596,7 +1966,10 @@ InstallAcpiPlatform (
   )
 {
   EFI_STATUS                    Status;
+  EFI_STATUS                    FingerprintStatus;
   EFI_EVENT                     EndOfDxeEvent;
+  UINT32                        Fingerprint;
+  UINT64                        StartTime;
 
   Status = gBS->LocateProtocol (&gEfiMpServiceProtocolGuid, NULL, (VOID **)&mMpService);
   ASSERT_EFI_ERROR (Status);
@@ -1642,8 +2015,21 @@ InstallAcpiPlatform (
 
   UpdateLocalTable ();
 
-  InstallMadtFromScratch ();
-  InstallMcfgFromScratch ();
+  StartTime = GetTimeInNanoSecond (GetPerformanceCounter ());
+  FingerprintStatus = GetAcpiHardwareFingerprint (&Fingerprint);
+  Status = FingerprintStatus;
+  if (!EFI_ERROR (Status)) {
+    Status = InstallCachedTables (Fingerprint, StartTime);
+  }
+
+  if (EFI_ERROR (Status)) {
+    StartTime = GetTimeInNanoSecond (GetPerformanceCounter ());
+    InstallMadtFromScratch ();
+    InstallMcfgFromScratch ();
+    if (!EFI_ERROR (FingerprintStatus)) {
+      SaveTablesToCache (Fingerprint, GetTimeInNanoSecond (GetPerformanceCounter ()) - StartTime);
+    }
+  }
 
   return EFI_SUCCESS;
 }
@@ -36,10 +36,14 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/PciSegmentInfoLib.h>
 #include <Library/SortLib.h>
 #include <Library/LocalApicLib.h>
+#include <Library/TimerLib.h>
 
 #include <Protocol/AcpiTable.h>
 #include <Protocol/MpService.h>
 #include <Protocol/PciIo.h>
+#include <Protocol/LoadedImage.h>
+#include <Pi/PiFirmwareVolume.h>
+#include <Protocol/FirmwareVolumeBlock.h>
 
 #include <Register/Cpuid.h>
 
@@ -0,0 +1,66 @@
+/** @file
+  Sort and search tables that map status code values to platform data.
+
+  A map is an array of fixed size entries terminated by an entry whose key is 0.
+  Every entry holds an EFI_STATUS_CODE_VALUE key and a UINT32 value at fixed
+  offsets, so the same routines serve maps with different entry layouts.
+
+  Copyright (c) 2020, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _STATUS_CODE_MAP_LIB_H_
+#define _STATUS_CODE_MAP_LIB_H_
+
+#include <Pi/PiStatusCode.h>
+
+/**
+  Sort a map by key so that it can be searched with SearchStatusCodeMap().
+
+  The sort is stable, so among entries that share a key the first one stays
+  first. The map must be writable.
+
+  @param[in, out]  Map          The map to sort, terminated by a 0 key.
+  @param[in]       EntrySize    Size in bytes of one map entry.
+  @param[in]       KeyOffset    Offset in bytes of the EFI_STATUS_CODE_VALUE
+                                key within an entry.
+
+  @return The number of entries in Map, not counting the terminator.
+**/
+UINTN
+EFIAPI
+SortStatusCodeMap (
+  IN OUT VOID   *Map,
+  IN     UINTN  EntrySize,
+  IN     UINTN  KeyOffset
+  );
+
+/**
+  Binary search a map that has been sorted by SortStatusCodeMap().
+
+  Several entries may share a key. The first one is returned, which is the
+  entry a linear scan of the unsorted map would have found.
+
+  @param[in]  Map           The sorted map to search.
+  @param[in]  Count         The number of entries in Map.
+  @param[in]  EntrySize     Size in bytes of one map entry.
+  @param[in]  KeyOffset     Offset in bytes of the EFI_STATUS_CODE_VALUE key
+                            within an entry.
+  @param[in]  ValueOffset   Offset in bytes of the UINT32 value within an entry.
+  @param[in]  Key           The status code value to look up.
+
+  @return The value of the matching entry, or 0 if Key is not in Map.
+**/
+UINT32
+EFIAPI
+SearchStatusCodeMap (
+  IN CONST VOID             *Map,
+  IN UINTN                  Count,
+  IN UINTN                  EntrySize,
+  IN UINTN                  KeyOffset,
+  IN UINTN                  ValueOffset,
+  IN EFI_STATUS_CODE_VALUE  Key
+  );
+
+#endif
@@ -39,6 +39,47 @@ typedef struct {
 //CHAR16  ErrorString[];
 } ADAPTER_INFO_PLATFORM_TEST_POINT;
 
+//
+// Test point profile table.
+//
+// The DXE test point check library records the start time and duration of
+// each test point it executes, and publishes the records as an EFI
+// configuration table identified by gTestPointProfileGuid. A phase marker
+// entry is inserted whenever the boot phase changes. All times are in
+// nanoseconds since the performance counter start value.
+//
+#define TEST_POINT_PROFILE_SIGNATURE              SIGNATURE_32 ('T', 'P', 'P', 'F')
+#define TEST_POINT_PROFILE_VERSION                0x00000001
+
+#define TEST_POINT_PROFILE_MAX_ENTRIES            64
+#define TEST_POINT_PROFILE_NAME_LENGTH            64
+
+#define TEST_POINT_PROFILE_PHASE_PCI_ENUMERATION_DONE   0x00000001
+#define TEST_POINT_PROFILE_PHASE_END_OF_DXE             0x00000002
+#define TEST_POINT_PROFILE_PHASE_DXE_SMM_READY_TO_LOCK  0x00000003
+#define TEST_POINT_PROFILE_PHASE_DXE_SMM_READY_TO_BOOT  0x00000004
+#define TEST_POINT_PROFILE_PHASE_READY_TO_BOOT          0x00000005
+#define TEST_POINT_PROFILE_PHASE_EXIT_BOOT_SERVICES     0x00000006
+
+#define TEST_POINT_PROFILE_ENTRY_PHASE_MARKER     BIT0
+#define TEST_POINT_PROFILE_ENTRY_VERIFIED         BIT1
+
+typedef struct {
+  UINT64  StartTime;
+  UINT64  Duration;
+  UINT32  Phase;
+  UINT32  Attributes;
+  CHAR8   Name[TEST_POINT_PROFILE_NAME_LENGTH];
+} TEST_POINT_PROFILE_ENTRY;
+
+typedef struct {
+  UINT32  Signature;
+  UINT32  Version;
+  UINT32  MaxEntries;
+  UINT32  EntryCount;
+//TEST_POINT_PROFILE_ENTRY Entry[MaxEntries];
+} TEST_POINT_PROFILE_TABLE;
+
 //
 // Below is test point report library
 //
@@ -213,5 +254,6 @@ typedef struct {
 } SMI_HANDLER_TEST_POINT_PARAMETER_GET_DATA_BY_OFFSET;
 
 extern EFI_GUID gAdapterInfoPlatformTestPointGuid;
+extern EFI_GUID gTestPointProfileGuid;
 
 #endif
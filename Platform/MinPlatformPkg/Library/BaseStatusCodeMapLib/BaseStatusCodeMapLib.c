@@ -0,0 +1,158 @@
+/** @file
+  Sort and search tables that map status code values to platform data.
+
+  Copyright (c) 2020, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Base.h>
+#include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
+#include <Library/StatusCodeMapLib.h>
+
+/**
+  Read the key of a map entry.
+
+  @param[in]  Map          The map.
+  @param[in]  Index        Index of the entry.
+  @param[in]  EntrySize    Size in bytes of one map entry.
+  @param[in]  KeyOffset    Offset in bytes of the key within an entry.
+
+  @return The key of the entry.
+**/
+STATIC
+EFI_STATUS_CODE_VALUE
+GetMapKey (
+  IN CONST UINT8  *Map,
+  IN UINTN        Index,
+  IN UINTN        EntrySize,
+  IN UINTN        KeyOffset
+  )
+{
+  return ReadUnaligned32 ((CONST UINT32 *) (Map + Index * EntrySize + KeyOffset));
+}
+
+/**
+  Exchange two map entries.
+
+  @param[in, out]  Entry1       The first entry.
+  @param[in, out]  Entry2       The second entry.
+  @param[in]       EntrySize    Size in bytes of one map entry.
+**/
+STATIC
+VOID
+SwapMapEntries (
+  IN OUT UINT8  *Entry1,
+  IN OUT UINT8  *Entry2,
+  IN     UINTN  EntrySize
+  )
+{
+  UINT8  Byte;
+
+  while (EntrySize-- > 0) {
+    Byte      = *Entry1;
+    *Entry1++ = *Entry2;
+    *Entry2++ = Byte;
+  }
+}
+
+/**
+  Sort a map by key so that it can be searched with SearchStatusCodeMap().
+
+  The sort is stable, so among entries that share a key the first one stays
+  first. The map must be writable.
+
+  @param[in, out]  Map          The map to sort, terminated by a 0 key.
+  @param[in]       EntrySize    Size in bytes of one map entry.
+  @param[in]       KeyOffset    Offset in bytes of the EFI_STATUS_CODE_VALUE
+                                key within an entry.
+
+  @return The number of entries in Map, not counting the terminator.
+**/
+UINTN
+EFIAPI
+SortStatusCodeMap (
+  IN OUT VOID   *Map,
+  IN     UINTN  EntrySize,
+  IN     UINTN  KeyOffset
+  )
+{
+  UINT8  *Entries;
+  UINTN  Count;
+  UINTN  Index;
+  UINTN  Slot;
+
+  ASSERT (Map != NULL);
+  ASSERT (KeyOffset + sizeof (EFI_STATUS_CODE_VALUE) <= EntrySize);
+
+  Entries = (UINT8 *) Map;
+  for (Count = 0; GetMapKey (Entries, Count, EntrySize, KeyOffset) != 0; Count++) {
+  }
+
+  //
+  // Insertion sort; the maps are small and are only sorted once.
+  //
+  for (Index = 1; Index < Count; Index++) {
+    for (Slot = Index;
+         (Slot > 0) &&
+         (GetMapKey (Entries, Slot - 1, EntrySize, KeyOffset) > GetMapKey (Entries, Slot, EntrySize, KeyOffset));
+         Slot--) {
+      SwapMapEntries (Entries + (Slot - 1) * EntrySize, Entries + Slot * EntrySize, EntrySize);
+    }
+  }
+
+  return Count;
+}
+
+/**
+  Binary search a map that has been sorted by SortStatusCodeMap().
+
+  Several entries may share a key. The first one is returned, which is the
+  entry a linear scan of the unsorted map would have found.
+
+  @param[in]  Map           The sorted map to search.
+  @param[in]  Count         The number of entries in Map.
+  @param[in]  EntrySize     Size in bytes of one map entry.
+  @param[in]  KeyOffset     Offset in bytes of the EFI_STATUS_CODE_VALUE key
+                            within an entry.
+  @param[in]  ValueOffset   Offset in bytes of the UINT32 value within an entry.
+  @param[in]  Key           The status code value to look up.
+
+  @return The value of the matching entry, or 0 if Key is not in Map.
+**/
+UINT32
+EFIAPI
+SearchStatusCodeMap (
+  IN CONST VOID             *Map,
+  IN UINTN                  Count,
+  IN UINTN                  EntrySize,
+  IN UINTN                  KeyOffset,
+  IN UINTN                  ValueOffset,
+  IN EFI_STATUS_CODE_VALUE  Key
+  )
+{
+  CONST UINT8  *Entries;
+  UINTN        Low;
+  UINTN        High;
+  UINTN        Middle;
+
+  ASSERT (ValueOffset + sizeof (UINT32) <= EntrySize);
+
+  Entries = (CONST UINT8 *) Map;
+  Low     = 0;
+  High    = Count;
+  while (Low < High) {
+    Middle = Low + (High - Low) / 2;
+    if (GetMapKey (Entries, Middle, EntrySize, KeyOffset) < Key) {
+      Low = Middle + 1;
+    } else {
+      High = Middle;
+    }
+  }
+
+  if ((Low < Count) && (GetMapKey (Entries, Low, EntrySize, KeyOffset) == Key)) {
+    return ReadUnaligned32 ((CONST UINT32 *) (Entries + Low * EntrySize + ValueOffset));
+  }
+  return 0;
+}
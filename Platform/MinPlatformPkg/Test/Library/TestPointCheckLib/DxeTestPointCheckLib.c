@@ -11,8 +11,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/TestPointLib.h>
 #include <Library/DebugLib.h>
 #include <Library/UefiLib.h>
+#include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
 #include <Library/SafeIntLib.h>
+#include <Library/TimerLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/TestPointCheckDmaProtectionLib.h>
 #include <IndustryStandard/Acpi.h>
@@ -161,6 +164,132 @@ GLOBAL_REMOVE_IF_UNREFERENCED ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT  mTestPoin
 
 GLOBAL_REMOVE_IF_UNREFERENCED UINT8  mFeatureImplemented[TEST_POINT_FEATURE_SIZE];
 
+GLOBAL_REMOVE_IF_UNREFERENCED CONST CHAR8  *mTestPointProfilePhaseName[] = {
+  "Unknown",
+  "PciEnumerationDone",
+  "EndOfDxe",
+  "DxeSmmReadyToLock",
+  "DxeSmmReadyToBoot",
+  "ReadyToBoot",
+  "ExitBootServices",
+};
+
+/**
+  Convert the performance counter delta between two values to nanoseconds.
+
+  @param[in]  From    The earlier performance counter value.
+  @param[in]  To      The later performance counter value.
+
+  @return The elapsed time in nanoseconds.
+**/
+UINT64
+TestPointProfileElapsedTime (
+  IN UINT64  From,
+  IN UINT64  To
+  )
+{
+  UINT64  CounterStart;
+  UINT64  CounterEnd;
+
+  GetPerformanceCounterProperties (&CounterStart, &CounterEnd);
+  if (CounterEnd < CounterStart) {
+    return GetTimeInNanoSecond (From - To);
+  }
+
+  return GetTimeInNanoSecond (To - From);
+}
+
+/**
+  Append one entry to the test point profile table.
+
+  The table is published as an EFI configuration table, so every module that
+  links this library appends to the same buffer and TestPointDumpApp can
+  retrieve it later. The table is allocated by the first test point that
+  completes; nothing is allocated once ExitBootServices() has been invoked.
+  A phase marker entry is inserted whenever the boot phase changes.
+
+  @param[in]  Name        The test point name.
+  @param[in]  Phase       The TEST_POINT_PROFILE_PHASE_* the test point runs in.
+  @param[in]  StartTime   The performance counter value when the test point was entered.
+  @param[in]  Verified    TRUE if the test point check passed.
+**/
+VOID
+TestPointProfileRecord (
+  IN CONST CHAR8  *Name,
+  IN UINT32       Phase,
+  IN UINT64       StartTime,
+  IN BOOLEAN      Verified
+  )
+{
+  EFI_STATUS                Status;
+  UINT64                    EndTime;
+  UINT64                    CounterStart;
+  TEST_POINT_PROFILE_TABLE  *Table;
+  TEST_POINT_PROFILE_ENTRY  *Entry;
+
+  EndTime = GetPerformanceCounter ();
+  GetPerformanceCounterProperties (&CounterStart, NULL);
+
+  DEBUG ((DEBUG_INFO, "%a - %ld ns\n", Name, TestPointProfileElapsedTime (StartTime, EndTime)));
+
+  Status = EfiGetSystemConfigurationTable (&gTestPointProfileGuid, (VOID **)&Table);
+  if (EFI_ERROR (Status)) {
+    if (Phase == TEST_POINT_PROFILE_PHASE_EXIT_BOOT_SERVICES) {
+      return;
+    }
+
+    Table = AllocateZeroPool (sizeof (TEST_POINT_PROFILE_TABLE) + TEST_POINT_PROFILE_MAX_ENTRIES * sizeof (TEST_POINT_PROFILE_ENTRY));
+    if (Table == NULL) {
+      return;
+    }
+
+    Table->Signature  = TEST_POINT_PROFILE_SIGNATURE;
+    Table->Version    = TEST_POINT_PROFILE_VERSION;
+    Table->MaxEntries = TEST_POINT_PROFILE_MAX_ENTRIES;
+    Table->EntryCount = 0;
+    Status = gBS->InstallConfigurationTable (&gTestPointProfileGuid, Table);
+    if (EFI_ERROR (Status)) {
+      FreePool (Table);
+      return;
+    }
+  }
+
+  if ((Table->Signature != TEST_POINT_PROFILE_SIGNATURE) || (Phase >= ARRAY_SIZE (mTestPointProfilePhaseName))) {
+    return;
+  }
+
+  //
+  // Keep one slot free for the test point itself when a marker is needed.
+  //
+  Entry = (TEST_POINT_PROFILE_ENTRY *)(Table + 1);
+  if ((Table->EntryCount == 0) || (Entry[Table->EntryCount - 1].Phase != Phase)) {
+    if (Table->EntryCount + 2 > Table->MaxEntries) {
+      return;
+    }
+
+    Entry              = &Entry[Table->EntryCount];
+    Entry->StartTime   = TestPointProfileElapsedTime (CounterStart, StartTime);
+    Entry->Duration    = 0;
+    Entry->Phase       = Phase;
+    Entry->Attributes  = TEST_POINT_PROFILE_ENTRY_PHASE_MARKER;
+    AsciiStrnCpyS (Entry->Name, sizeof (Entry->Name), mTestPointProfilePhaseName[Phase], sizeof (Entry->Name) - 1);
+    Table->EntryCount++;
+    Entry = (TEST_POINT_PROFILE_ENTRY *)(Table + 1);
+  }
+
+  if (Table->EntryCount >= Table->MaxEntries) {
+    return;
+  }
+
+  Entry              = &Entry[Table->EntryCount];
+  Entry->StartTime   = TestPointProfileElapsedTime (CounterStart, StartTime);
+  Entry->Duration    = TestPointProfileElapsedTime (StartTime, EndTime);
+  Entry->Phase       = Phase;
+  Entry->Attributes  = Verified ? TEST_POINT_PROFILE_ENTRY_VERIFIED : 0;
+  AsciiStrnCpyS (Entry->Name, sizeof (Entry->Name), Name, sizeof (Entry->Name) - 1);
+  Table->EntryCount++;
+}
+
 /**
   This service verifies bus master enable (BME) is disabled after PCI enumeration.
 
@@ -180,12 +309,14 @@ TestPointPciEnumerationDonePciBusMasterDisabled (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[3] & TEST_POINT_BYTE3_PCI_ENUMERATION_DONE_BUS_MASTER_DISABLED) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointPciEnumerationDonePciBusMasterDisabled - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckPciBusMaster ();
@@ -202,6 +333,8 @@ TestPointPciEnumerationDonePciBusMasterDisabled (
       );
   }
 
+  TestPointProfileRecord ("TestPointPciEnumerationDonePciBusMasterDisabled", TEST_POINT_PROFILE_PHASE_PCI_ENUMERATION_DONE, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointPciEnumerationDonePciBusMasterDisabled - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -225,12 +358,14 @@ TestPointPciEnumerationDonePciResourceAllocated (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[3] & TEST_POINT_BYTE3_PCI_ENUMERATION_DONE_RESOURCE_ALLOCATED) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointPciEnumerationDonePciResourceAllocated - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckPciResource ();
@@ -247,6 +382,8 @@ TestPointPciEnumerationDonePciResourceAllocated (
       );
   }
 
+  TestPointProfileRecord ("TestPointPciEnumerationDonePciResourceAllocated", TEST_POINT_PROFILE_PHASE_PCI_ENUMERATION_DONE, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointPciEnumerationDonePciResourceAllocated - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -270,12 +407,14 @@ TestPointEndOfDxeDmaAcpiTableFunctional (
 {
   EFI_STATUS  Status;
   VOID        *Acpi;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[3] & TEST_POINT_BYTE3_END_OF_DXE_DMA_ACPI_TABLE_FUNCTIONAL) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointEndOfDxeDmaAcpiTableFunctional - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Acpi = TestPointGetAcpi (EFI_ACPI_6_5_DMA_REMAPPING_TABLE_SIGNATURE);
   if (Acpi == NULL) {
@@ -298,6 +437,8 @@ TestPointEndOfDxeDmaAcpiTableFunctional (
     Status = EFI_SUCCESS;
   }
 
+  TestPointProfileRecord ("TestPointEndOfDxeDmaAcpiTableFunctional", TEST_POINT_PROFILE_PHASE_END_OF_DXE, StartTime, !EFI_ERROR (Status));
+
   DEBUG ((DEBUG_INFO, "======== TestPointEndOfDxeDmaAcpiTableFunctional - Exit\n"));
   return Status;
 }
@@ -321,12 +462,14 @@ TestPointEndOfDxeDmaProtectionEnabled (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[3] & TEST_POINT_BYTE3_END_OF_DXE_DMA_PROTECTION_ENABLED) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointEndOfDxeDmaProtectionEnabled - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointVtdEngine ();
@@ -343,6 +486,8 @@ TestPointEndOfDxeDmaProtectionEnabled (
       );
   }
 
+  TestPointProfileRecord ("TestPointEndOfDxeDmaProtectionEnabled", TEST_POINT_PROFILE_PHASE_END_OF_DXE, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointEndOfDxeDmaProtectionEnabled - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -366,12 +511,14 @@ TestPointEndOfDxeNoThirdPartyPciOptionRom (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[3] & TEST_POINT_BYTE3_END_OF_DXE_NO_THIRD_PARTY_PCI_OPTION_ROM) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointEndOfDxeNoThirdPartyPciOptionRom - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckLoadedImage ();
@@ -388,6 +535,8 @@ TestPointEndOfDxeNoThirdPartyPciOptionRom (
       );
   }
 
+  TestPointProfileRecord ("TestPointEndOfDxeNoThirdPartyPciOptionRom", TEST_POINT_PROFILE_PHASE_END_OF_DXE, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointEndOfDxeNoThirdPartyPciOptionRom - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -411,12 +560,14 @@ TestPointDxeSmmReadyToLockSmramAligned (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[7] & TEST_POINT_BYTE7_DXE_SMM_READY_TO_LOCK_SMRAM_ALIGNED) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointDxeSmmReadyToLockSmramAligned - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckSmmInfo ();
@@ -433,6 +584,8 @@ TestPointDxeSmmReadyToLockSmramAligned (
       );
   }
 
+  TestPointProfileRecord ("TestPointDxeSmmReadyToLockSmramAligned", TEST_POINT_PROFILE_PHASE_DXE_SMM_READY_TO_LOCK, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointDxeSmmReadyToLockSmramAligned - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -457,12 +610,14 @@ TestPointDxeSmmReadyToLockWsmtTableFunctional (
 {
   EFI_STATUS  Status;
   VOID        *Acpi;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[7] & TEST_POINT_BYTE7_DXE_SMM_READY_TO_LOCK_WSMT_TABLE_FUNCTIONAL) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointDxeSmmReadyToLockWsmtTableFunctional - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Acpi = TestPointGetAcpi (EFI_ACPI_WINDOWS_SMM_SECURITY_MITIGATION_TABLE_SIGNATURE);
   if (Acpi == NULL) {
@@ -485,6 +640,8 @@ TestPointDxeSmmReadyToLockWsmtTableFunctional (
     Status = EFI_SUCCESS;
   }
 
+  TestPointProfileRecord ("TestPointDxeSmmReadyToLockWsmtTableFunctional", TEST_POINT_PROFILE_PHASE_DXE_SMM_READY_TO_LOCK, StartTime, !EFI_ERROR (Status));
+
   DEBUG ((DEBUG_INFO, "======== TestPointDxeSmmReadyToLockWsmtTableFunctional - Exit\n"));
   return Status;
 }
@@ -527,12 +684,14 @@ TestPointDxeSmmReadyToBootSmmPageProtection (
   EFI_MEMORY_DESCRIPTOR                               *Entry;
   UINTN                                               Size;
   TEST_POINT_SMM_COMMUNICATION_UEFI_GCD_MAP_INFO      *CommData;
+  UINT64                                              StartTime;
 
   if ((mFeatureImplemented[6] & TEST_POINT_BYTE6_SMM_READY_TO_BOOT_SMM_PAGE_LEVEL_PROTECTION) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointDxeSmmReadyToBootSmmPageProtection - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   TestPointDumpUefiMemoryMap (&UefiMemoryMap, &UefiMemoryMapSize, &UefiDescriptorSize, FALSE);
   TestPointDumpGcd (&GcdMemoryMap, &GcdMemoryMapNumberOfDescriptors, &GcdIoMap, &GcdIoMapNumberOfDescriptors, FALSE);
@@ -636,6 +795,8 @@ TestPointDxeSmmReadyToBootSmmPageProtection (
     return EFI_SUCCESS;
   }
 
+  TestPointProfileRecord ("TestPointDxeSmmReadyToBootSmmPageProtection", TEST_POINT_PROFILE_PHASE_DXE_SMM_READY_TO_BOOT, StartTime, TRUE);
+
   DEBUG ((DEBUG_INFO, "======== TestPointDxeSmmReadyToBootSmmPageProtection - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -659,12 +820,14 @@ TestPointDxeSmmReadyToBootSmiHandlerInstrument (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[7] & TEST_POINT_BYTE7_DXE_SMM_READY_TO_BOOT_SMI_HANDLER_INSTRUMENT) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointDxeSmmReadyToBootSmiHandlerInstrument - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckSmiHandlerInstrument ();
@@ -681,6 +844,8 @@ TestPointDxeSmmReadyToBootSmiHandlerInstrument (
       );
   }
 
+  TestPointProfileRecord ("TestPointDxeSmmReadyToBootSmiHandlerInstrument", TEST_POINT_PROFILE_PHASE_DXE_SMM_READY_TO_BOOT, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointDxeSmmReadyToBootSmiHandlerInstrument - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -704,12 +869,14 @@ TestPointReadyToBootAcpiTableFunctional (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[4] & TEST_POINT_BYTE4_READY_TO_BOOT_ACPI_TABLE_FUNCTIONAL) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootAcpiTableFunctional - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckAcpi ();
@@ -726,6 +893,8 @@ TestPointReadyToBootAcpiTableFunctional (
       );
   }
 
+  TestPointProfileRecord ("TestPointReadyToBootAcpiTableFunctional", TEST_POINT_PROFILE_PHASE_READY_TO_BOOT, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootAcpiTableFunctional - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -749,12 +918,14 @@ TestPointReadyToBootGcdResourceFunctional (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[4] & TEST_POINT_BYTE4_READY_TO_BOOT_GCD_RESOURCE_FUNCTIONAL) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootGcdResourceFunctional - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckAcpiGcdResource ();
@@ -771,6 +942,8 @@ TestPointReadyToBootGcdResourceFunctional (
       );
   }
 
+  TestPointProfileRecord ("TestPointReadyToBootGcdResourceFunctional", TEST_POINT_PROFILE_PHASE_READY_TO_BOOT, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootGcdResourceFunctional - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -795,12 +968,14 @@ TestPointReadyToBootMemoryTypeInformationFunctional (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[4] & TEST_POINT_BYTE4_READY_TO_BOOT_MEMORY_TYPE_INFORMATION_FUNCTIONAL) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootMemoryTypeInformationFunctional - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckMemoryTypeInformation ();
@@ -822,6 +997,8 @@ TestPointReadyToBootMemoryTypeInformationFunctional (
       );
   }
 
+  TestPointProfileRecord ("TestPointReadyToBootMemoryTypeInformationFunctional", TEST_POINT_PROFILE_PHASE_READY_TO_BOOT, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootMemoryTypeInformationFunctional - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -846,12 +1023,14 @@ TestPointReadyToBootUefiMemoryAttributeTableFunctional (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[4] & TEST_POINT_BYTE4_READY_TO_BOOT_UEFI_MEMORY_ATTRIBUTE_TABLE_FUNCTIONAL) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootUefiMemoryAttributeTableFunctional - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   TestPointDumpUefiMemoryMap (NULL, NULL, NULL, TRUE);
@@ -870,6 +1049,8 @@ TestPointReadyToBootUefiMemoryAttributeTableFunctional (
       );
   }
 
+  TestPointProfileRecord ("TestPointReadyToBootUefiMemoryAttributeTableFunctional", TEST_POINT_PROFILE_PHASE_READY_TO_BOOT, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootUefiMemoryAttributeTableFunctional - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -893,12 +1074,14 @@ TestPointReadyToBootUefiBootVariableFunctional (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[4] & TEST_POINT_BYTE4_READY_TO_BOOT_UEFI_BOOT_VARIABLE_FUNCTIONAL) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootUefiBootVariableFunctional - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   TestPointDumpDevicePath ();
@@ -917,6 +1100,8 @@ TestPointReadyToBootUefiBootVariableFunctional (
       );
   }
 
+  TestPointProfileRecord ("TestPointReadyToBootUefiBootVariableFunctional", TEST_POINT_PROFILE_PHASE_READY_TO_BOOT, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootUefiBootVariableFunctional - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -940,12 +1125,14 @@ TestPointReadyToBootUefiConsoleVariableFunctional (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[4] & TEST_POINT_BYTE4_READY_TO_BOOT_UEFI_CONSOLE_VARIABLE_FUNCTIONAL) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootUefiConsoleVariableFunctional - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   TestPointDumpDevicePath ();
@@ -964,6 +1151,8 @@ TestPointReadyToBootUefiConsoleVariableFunctional (
       );
   }
 
+  TestPointProfileRecord ("TestPointReadyToBootUefiConsoleVariableFunctional", TEST_POINT_PROFILE_PHASE_READY_TO_BOOT, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootUefiConsoleVariableFunctional - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -987,12 +1176,14 @@ TestPointReadyToBootHstiTableFunctional (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[8] & TEST_POINT_BYTE8_READY_TO_BOOT_HSTI_TABLE_FUNCTIONAL) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootHstiTableFunctional - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckHsti ();
@@ -1009,6 +1200,8 @@ TestPointReadyToBootHstiTableFunctional (
       );
   }
 
+  TestPointProfileRecord ("TestPointReadyToBootHstiTableFunctional", TEST_POINT_PROFILE_PHASE_READY_TO_BOOT, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootHstiTableFunctional - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -1032,12 +1225,14 @@ TestPointReadyToBootEsrtTableFunctional (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[8] & TEST_POINT_BYTE8_READY_TO_BOOT_ESRT_TABLE_FUNCTIONAL) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootEsrtTableFunctional - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckEsrt ();
@@ -1054,6 +1249,8 @@ TestPointReadyToBootEsrtTableFunctional (
       );
   }
 
+  TestPointProfileRecord ("TestPointReadyToBootEsrtTableFunctional", TEST_POINT_PROFILE_PHASE_READY_TO_BOOT, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootEsrtTableFunctional - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -1077,12 +1274,14 @@ TestPointReadyToBootUefiSecureBootEnabled (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[5] & TEST_POINT_BYTE5_READY_TO_BOOT_UEFI_SECURE_BOOT_ENABLED) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootUefiSecureBootEnabled - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckUefiSecureBoot ();
@@ -1099,6 +1298,8 @@ TestPointReadyToBootUefiSecureBootEnabled (
       );
   }
 
+  TestPointProfileRecord ("TestPointReadyToBootUefiSecureBootEnabled", TEST_POINT_PROFILE_PHASE_READY_TO_BOOT, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootUefiSecureBootEnabled - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -1121,12 +1322,14 @@ TestPointReadyToBootPiSignedFvBootEnabled (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[5] & TEST_POINT_BYTE5_READY_TO_BOOT_PI_SIGNED_FV_BOOT_ENABLED) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootPiSignedFvBootEnabled - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckPiSignedFvBoot ();
@@ -1143,6 +1346,8 @@ TestPointReadyToBootPiSignedFvBootEnabled (
       );
   }
 
+  TestPointProfileRecord ("TestPointReadyToBootPiSignedFvBootEnabled", TEST_POINT_PROFILE_PHASE_READY_TO_BOOT, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootPiSignedFvBootEnabled - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -1166,12 +1371,14 @@ TestPointReadyToBootTcgTrustedBootEnabled (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[5] & TEST_POINT_BYTE5_READY_TO_BOOT_TCG_TRUSTED_BOOT_ENABLED) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootTcgTrustedBootEnabled - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckTcgTrustedBoot ();
@@ -1188,6 +1395,8 @@ TestPointReadyToBootTcgTrustedBootEnabled (
       );
   }
 
+  TestPointProfileRecord ("TestPointReadyToBootTcgTrustedBootEnabled", TEST_POINT_PROFILE_PHASE_READY_TO_BOOT, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootTcgTrustedBootEnabled - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -1211,12 +1420,14 @@ TestPointReadyToBootTcgMorEnabled (
 {
   EFI_STATUS  Status;
   BOOLEAN     Result;
+  UINT64      StartTime;
 
   if ((mFeatureImplemented[5] & TEST_POINT_BYTE5_READY_TO_BOOT_TCG_MOR_ENABLED) == 0) {
     return EFI_SUCCESS;
   }
 
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootTcgMorEnabled - Enter\n"));
+  StartTime = GetPerformanceCounter ();
 
   Result = TRUE;
   Status = TestPointCheckTcgMor ();
@@ -1233,6 +1444,8 @@ TestPointReadyToBootTcgMorEnabled (
       );
   }
 
+  TestPointProfileRecord ("TestPointReadyToBootTcgMorEnabled", TEST_POINT_PROFILE_PHASE_READY_TO_BOOT, StartTime, Result);
+
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootTcgMorEnabled - Exit\n"));
   return EFI_SUCCESS;
 }
@@ -1248,7 +1461,12 @@ TestPointExitBootServices (
   VOID
   )
 {
+  UINT64  StartTime;
+
   DEBUG ((DEBUG_INFO, "======== TestPointExitBootServices - Enter\n"));
+  StartTime = GetPerformanceCounter ();
+
+  TestPointProfileRecord ("TestPointExitBootServices", TEST_POINT_PROFILE_PHASE_EXIT_BOOT_SERVICES, StartTime, TRUE);
 
   DEBUG ((DEBUG_INFO, "======== TestPointExitBootServices - Exit\n"));
 
@@ -14,6 +14,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/UefiLib.h>
 #include <Library/TestPointLib.h>
 #include <Protocol/AdapterInformation.h>
+#include <Protocol/LoadedImage.h>
 
 VOID
 DumpTestPoint (
@@ -159,6 +160,67 @@ DumpTestPointDataDxe (
   FreePool (Handles);
 }
 
+/**
+  Dump the test point profile table as CSV or JSON.
+
+  @param[in]  Json    TRUE to dump JSON, FALSE to dump CSV.
+**/
+VOID
+DumpTestPointProfile (
+  IN BOOLEAN                  Json
+  )
+{
+  EFI_STATUS                Status;
+  TEST_POINT_PROFILE_TABLE  *Table;
+  TEST_POINT_PROFILE_ENTRY  *Entry;
+  UINTN                     Index;
+  UINTN                     EntryCount;
+
+  Status = EfiGetSystemConfigurationTable (&gTestPointProfileGuid, (VOID **)&Table);
+  if (EFI_ERROR (Status) || (Table->Signature != TEST_POINT_PROFILE_SIGNATURE)) {
+    return ;
+  }
+
+  EntryCount = MIN (Table->EntryCount, Table->MaxEntries);
+  Entry = (TEST_POINT_PROFILE_ENTRY *)(Table + 1);
+
+  if (Json) {
+    Print (L"{\"Version\":%d,\"Entries\":[", Table->Version);
+  } else {
+    Print (L"TestPointProfile\n");
+    Print (L"Type,Phase,Name,StartTimeNs,DurationNs,Verified\n");
+  }
+
+  for (Index = 0; Index < EntryCount; Index++, Entry++) {
+    if (Json) {
+      Print (
+        L"%a\n  {\"Type\":\"%a\",\"Phase\":%d,\"Name\":\"%a\",\"StartTimeNs\":%ld,\"DurationNs\":%ld,\"Verified\":%a}",
+        (Index == 0) ? "" : ",",
+        ((Entry->Attributes & TEST_POINT_PROFILE_ENTRY_PHASE_MARKER) != 0) ? "Phase" : "TestPoint",
+        Entry->Phase,
+        Entry->Name,
+        Entry->StartTime,
+        Entry->Duration,
+        ((Entry->Attributes & TEST_POINT_PROFILE_ENTRY_VERIFIED) != 0) ? "true" : "false"
+        );
+    } else {
+      Print (
+        L"%a,%d,%a,%ld,%ld,%d\n",
+        ((Entry->Attributes & TEST_POINT_PROFILE_ENTRY_PHASE_MARKER) != 0) ? "Phase" : "TestPoint",
+        Entry->Phase,
+        Entry->Name,
+        Entry->StartTime,
+        Entry->Duration,
+        ((Entry->Attributes & TEST_POINT_PROFILE_ENTRY_VERIFIED) != 0) ? 1 : 0
+        );
+    }
+  }
+
+  if (Json) {
+    Print (L"\n]}\n");
+  }
+}
+
 EFI_STATUS
 EFIAPI
 TestPointDumpAppEntrypoint (
@@ -166,7 +228,23 @@ TestPointDumpAppEntrypoint (
   IN EFI_SYSTEM_TABLE     *SystemTable
   )
 {
-  DumpTestPointDataDxe (0, NULL);
+  EFI_STATUS                  Status;
+  EFI_LOADED_IMAGE_PROTOCOL   *LoadedImage;
+  BOOLEAN                     Json;
+
+  //
+  // "TestPointDumpApp -json" dumps the profile as JSON instead of CSV.
+  //
+  Json = FALSE;
+  Status = gBS->HandleProtocol (ImageHandle, &gEfiLoadedImageProtocolGuid, (VOID **)&LoadedImage);
+  if (!EFI_ERROR (Status) && (LoadedImage->LoadOptions != NULL) && (LoadedImage->LoadOptionsSize >= sizeof (CHAR16))) {
+    Json = (BOOLEAN)(StrStr (LoadedImage->LoadOptions, L"-json") != NULL);
+  }
+
+  if (!Json) {
+    DumpTestPointDataDxe (0, NULL);
+  }
+  DumpTestPointProfile (Json);
 
   return EFI_SUCCESS;
 }
@@ -86,6 +86,36 @@ EFI_FW_VOL_BLOCK_DEVICE mFvbDeviceTemplate = {
 };
 
 
+STATIC
+VOID
+VarStoreMarkDirty (
+  IN UINTN Address,
+  IN UINTN Length
+  )
+{
+  UINTN Block;
+  UINTN LastBlock;
+
+  mFvInstance->Dirty = TRUE;
+
+  if (Length == 0) {
+    return;
+  }
+
+  //
+  // Remember which blocks changed so that only those get written
+  // back to the backing file.
+  //
+  Block = (Address - mFvInstance->FvBase) / mFvInstance->BlockSize;
+  LastBlock = (Address + Length - 1 - mFvInstance->FvBase) / mFvInstance->BlockSize;
+  ASSERT (LastBlock < mFvInstance->NumOfDirtyBits);
+
+  for (; Block <= LastBlock; Block++) {
+    mFvInstance->DirtyMap[Block / 8] |= (UINT8)(1 << (Block % 8));
+  }
+}
+
+
 EFI_STATUS
 VarStoreWrite (
   IN     UINTN Address,
@@ -94,7 +124,7 @@ VarStoreWrite (
   )
 {
   CopyMem ((VOID*)Address, Buffer, *NumBytes);
-  mFvInstance->Dirty = TRUE;
+  VarStoreMarkDirty (Address, *NumBytes);
 
   return EFI_SUCCESS;
 }
@@ -107,7 +137,7 @@ VarStoreErase (
   )
 {
   SetMem ((VOID*)Address, LbaLength, 0xff);
-  mFvInstance->Dirty = TRUE;
+  VarStoreMarkDirty (Address, LbaLength);
 
   return EFI_SUCCESS;
 }
@@ -843,6 +873,15 @@ FvbInitialize (
   mFvInstance->FvBase = (UINTN)BaseAddress;
   mFvInstance->FvLength = (UINTN)Length;
   mFvInstance->Offset = StartOffset;
+  mFvInstance->BlockSize = PcdGet32 (PcdFirmwareBlockSize);
+  mFvInstance->NumOfDirtyBits = (Length + mFvInstance->BlockSize - 1) /
+                                  mFvInstance->BlockSize;
+  mFvInstance->DirtyMap = AllocateRuntimeZeroPool (
+                            (mFvInstance->NumOfDirtyBits + 7) / 8);
+  if (mFvInstance->DirtyMap == NULL) {
+    FreePool (mFvInstance);
+    return EFI_OUT_OF_RESOURCES;
+  }
   /*
    * Should I parse config.txt instead and find the real name?
    */
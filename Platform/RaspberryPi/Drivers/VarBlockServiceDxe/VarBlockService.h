@@ -33,6 +33,9 @@ typedef struct {
   EFI_DEVICE_PATH_PROTOCOL   *Device;
   CHAR16                     *MappedFile;
   BOOLEAN                    Dirty;
+  UINTN                      BlockSize;
+  UINTN                      NumOfDirtyBits;
+  UINT8                      *DirtyMap;   // One bit per BlockSize block of the FV
 } EFI_FW_VOL_INSTANCE;
 
 extern EFI_FW_VOL_INSTANCE *mFvInstance;
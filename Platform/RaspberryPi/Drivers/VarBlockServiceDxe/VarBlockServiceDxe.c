@@ -10,6 +10,7 @@
 
 #include "VarBlockService.h"
 
+#include <Library/BaseMemoryLib.h>
 #include <Protocol/ResetNotification.h>
 
 //
@@ -110,6 +111,7 @@ FvbVirtualAddressChangeEvent (
 {
   EfiConvertPointer (0x0, (VOID**)&mFvInstance->FvBase);
   EfiConvertPointer (0x0, (VOID**)&mFvInstance->VolumeHeader);
+  EfiConvertPointer (0x0, (VOID**)&mFvInstance->DirtyMap);
   EfiConvertPointer (0x0, (VOID**)&mFvInstance);
 }
 
@@ -134,14 +136,34 @@ InstallVirtualAddressChangeHandler (
 }
 
 
+STATIC
+BOOLEAN
+IsBlockDirty (
+  IN UINTN Block
+  )
+{
+  return (BOOLEAN)((mFvInstance->DirtyMap[Block / 8] & (1 << (Block % 8))) != 0);
+}
+
+
+//
+// Write back the FV to the backing file. With OnlyDirty set, only the
+// blocks changed since the last dump are written, each run of contiguous
+// dirty blocks with a single SetPosition/Write.
+//
 STATIC
 EFI_STATUS
 DoDump (
-  IN EFI_DEVICE_PATH_PROTOCOL *Device
+  IN EFI_DEVICE_PATH_PROTOCOL *Device,
+  IN BOOLEAN                  OnlyDirty
   )
 {
   EFI_STATUS Status;
   EFI_FILE_PROTOCOL *File;
+  UINTN Block;
+  UINTN RunStart;
+  UINTN RunLength;
+  UINTN Written;
 
   Status = FileOpen (Device,
              mFvInstance->MappedFile,
@@ -152,11 +174,44 @@ DoDump (
     return Status;
   }
 
-  Status = FileWrite (File,
-             mFvInstance->Offset,
-             mFvInstance->FvBase,
-             mFvInstance->FvLength);
+  if (!OnlyDirty) {
+    Status = FileWrite (File,
+               mFvInstance->Offset,
+               mFvInstance->FvBase,
+               mFvInstance->FvLength);
+    Written = mFvInstance->FvLength;
+  } else {
+    Written = 0;
+    for (Block = 0; Block < mFvInstance->NumOfDirtyBits; Block++) {
+      if (!IsBlockDirty (Block)) {
+        continue;
+      }
+
+      RunStart = Block;
+      while (Block < mFvInstance->NumOfDirtyBits && IsBlockDirty (Block)) {
+        Block++;
+      }
+
+      RunLength = MIN ((Block - RunStart) * mFvInstance->BlockSize,
+                    mFvInstance->FvLength - RunStart * mFvInstance->BlockSize);
+      Status = FileWrite (File,
+                 mFvInstance->Offset + RunStart * mFvInstance->BlockSize,
+                 mFvInstance->FvBase + RunStart * mFvInstance->BlockSize,
+                 RunLength);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+      Written += RunLength;
+    }
+  }
+
   FileClose (File);
+
+  if (!EFI_ERROR (Status)) {
+    ZeroMem (mFvInstance->DirtyMap, (mFvInstance->NumOfDirtyBits + 7) / 8);
+    DEBUG ((DEBUG_INFO, "Wrote 0x%lx of 0x%lx variable store bytes\n",
+      (UINT64)Written, (UINT64)mFvInstance->FvLength));
+  }
   return Status;
 }
 
@@ -180,7 +235,7 @@ DumpVars (
     return;
   }
 
-  Status = DoDump (mFvInstance->Device);
+  Status = DoDump (mFvInstance->Device, TRUE);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Couldn't dump '%s'\n", mFvInstance->MappedFile));
     ASSERT_EFI_ERROR (Status);
@@ -334,7 +389,7 @@ OnSimpleFileSystemInstall (
       continue;
     }
 
-    Status = DoDump (Device);
+    Status = DoDump (Device, FALSE);
     if (EFI_ERROR (Status)) {
       DEBUG ((DEBUG_ERROR, "Couldn't update '%s'\n", mFvInstance->MappedFile));
       ASSERT_EFI_ERROR (Status);
@@ -84,8 +84,59 @@ typedef enum {
 #define GET_REG_NUM(Address)    ((Address) & REG_NUM)
 #define GET_SEG_NUM(Address)    (((Address) >> SEG_OFFSET) & 0xFFFF)
 
+/* Bus, Device, Function bits of a BDF table entry */
+#define BDF_MASK                0xFFFF000
+#define BDF_BITMAP_INDEX(Bdf)   (((Bdf) & BDF_MASK) >> FUNC_OFFSET)
+#define BDF_BITMAP_SIZE         ((BDF_MASK >> FUNC_OFFSET) / 8 + 1)
+#define BDF_SEGMENT_COUNT       2
+
 CONST STATIC UINTN mDummyConfigData = 0xFFFFFFFF;
 
+/* One bit per Bus/Device/Function, built from the SCP BDF table on first use */
+STATIC UINT8    mBdfBitmap[BDF_SEGMENT_COUNT][BDF_BITMAP_SIZE];
+STATIC BOOLEAN  mBdfBitmapReady[BDF_SEGMENT_COUNT];
+
+/**
+  Build the valid BDF bitmap of a segment from the SCP provided BDF table.
+
+  The table lives in uncached non-secure SRAM and is static once SCP has
+  finished its bus scan, so it is walked only once per segment.
+
+  @param  Segment   The PCI segment number.
+  @param  TableBase Base address of the segment's BDF table.
+
+**/
+STATIC
+VOID
+BuildBdfBitmap (
+  IN UINT16                    Segment,
+  IN UINTN                     TableBase
+  )
+{
+  UINTN   BdfCount;
+  UINTN   BdfValue;
+  UINTN   Count;
+  UINTN   Index;
+
+  BdfCount = MmioRead32 (TableBase + BDF_TABLE_ENTRY_SIZE);
+
+  /* Start from the second entry */
+  for (Count = BDF_TABLE_HEADER_COUNT;
+       Count < (BdfCount + BDF_TABLE_HEADER_COUNT);
+       Count++) {
+    BdfValue = MmioRead32 (TableBase + (Count * BDF_TABLE_ENTRY_SIZE));
+    if ((BdfValue & ~BDF_MASK) != 0) {
+      /* Never matched a config access before either, skip it */
+      continue;
+    }
+
+    Index = BDF_BITMAP_INDEX (BdfValue);
+    mBdfBitmap[Segment][Index / 8] |= (UINT8)(1 << (Index % 8));
+  }
+
+  mBdfBitmapReady[Segment] = TRUE;
+}
+
 /**
   Check if the requested PCI address is a valid BDF address.
 
@@ -108,16 +159,14 @@ IsBdfValid (
   )
 {
   UINT16  Segment;
-  UINTN   BdfCount;
-  UINTN   BdfValue;
-  UINTN   Count;
   UINTN   TableBase;
   UINTN   PciAddress;
+  UINTN   Index;
 
   Segment = GET_SEG_NUM (Address);
 
   // Keep the Bus, Device, Function bits. Clear the rest.
-  PciAddress = Address & 0xFFFF000;
+  PciAddress = Address & BDF_MASK;
 
   if (Segment == 0) {
     TableBase = NEOVERSEN1SOC_NON_SECURE_SRAM_BASE + PCIE_BDF_TABLE_OFFSET;
@@ -128,19 +177,12 @@ IsBdfValid (
     return mDummyConfigData;
   }
 
-  BdfCount = MmioRead32 (TableBase + BDF_TABLE_ENTRY_SIZE);
-
-  /* Start from the second entry */
-  for (Count = BDF_TABLE_HEADER_COUNT;
-       Count < (BdfCount + BDF_TABLE_HEADER_COUNT);
-       Count++) {
-    BdfValue = MmioRead32 (TableBase + (Count * BDF_TABLE_ENTRY_SIZE));
-    if (BdfValue == PciAddress) {
-      break;
-    }
+  if (!mBdfBitmapReady[Segment]) {
+    BuildBdfBitmap (Segment, TableBase);
   }
 
-  if (Count == (BdfCount + BDF_TABLE_HEADER_COUNT)) {
+  Index = BDF_BITMAP_INDEX (PciAddress);
+  if ((mBdfBitmap[Segment][Index / 8] & (1 << (Index % 8))) == 0) {
     return mDummyConfigData;
   } else {
     return PciAddress;
@@ -1798,6 +1798,109 @@ Ac01PcieCoreUpdateLink (
   }
 }
 
+/**
+  Check whether a link runs at the maximum speed and width of the Root Port.
+
+  @param RootComplex          Pointer to AC01_ROOT_COMPLEX structure
+  @param PcieIndex            PCIe controller index
+
+  @retval TRUE                The link cannot train any higher.
+  @retval FALSE               The link may still retrain to a higher speed or width.
+**/
+STATIC
+BOOLEAN
+Ac01PcieCoreLinkAtMaxCapability (
+  IN AC01_ROOT_COMPLEX  *RootComplex,
+  IN UINT8              PcieIndex
+  )
+{
+  PHYSICAL_ADDRESS  CfgBase;
+  UINT32            LinkCap;
+  UINT32            LinkStat;
+
+  CfgBase  = RootComplex->MmcfgBase + (RootComplex->Pcie[PcieIndex].DevNum << DEV_SHIFT);
+  LinkCap  = MmioRead32 (CfgBase + PCIE_CAPABILITY_BASE + LINK_CAPABILITIES_REG);
+  LinkStat = MmioRead32 (CfgBase + PCIE_CAPABILITY_BASE + LINK_CONTROL_LINK_STATUS_REG);
+
+  return (CAP_NEGO_LINK_WIDTH_GET (LinkStat) == CAP_MAX_LINK_WIDTH_GET (LinkCap)) &&
+         (CAP_LINK_SPEED_GET (LinkStat) == CAP_MAX_LINK_SPEED_GET (LinkCap));
+}
+
+/**
+  Poll the LTSSM of every controller still training and record when it reaches L0.
+
+  Link training was started on all controllers of all Root Complexes by
+  Ac01PcieCoreSetupRC(), so the links train concurrently and one pass over
+  the list services all of them.
+
+  A link first reaches L0 at Gen1 and only then retrains to its target speed
+  and width. A controller is therefore done only when it is in L0 at the
+  maximum speed and width of the Root Port, or when LINK_SETTLE_TIMEOUT has
+  passed since its first L0, e.g. because the Endpoint supports less.
+
+  @param RootComplexList      Pointer to the Root Complex list
+  @param ElapsedUs            Time elapsed since the polling started
+  @param LinkUpTime           Per controller time to first L0, 0 if not up yet
+
+  @retval TRUE                All active controllers are done training.
+  @retval FALSE               Some active controllers are still training.
+**/
+STATIC
+BOOLEAN
+Ac01PcieCorePollLinks (
+  IN     AC01_ROOT_COMPLEX  *RootComplexList,
+  IN     UINT32             ElapsedUs,
+  IN OUT UINT32             LinkUpTime[AC01_PCIE_MAX_ROOT_COMPLEX][MaxPcieControllerOfRootComplexB]
+  )
+{
+  AC01_ROOT_COMPLEX     *RootComplex;
+  AC01_PCIE_CONTROLLER  *Pcie;
+  UINT8                 RCIndex;
+  UINT8                 PcieIndex;
+  BOOLEAN               AllLinkUp;
+
+  AllLinkUp = TRUE;
+  for (RCIndex = 0; RCIndex < AC01_PCIE_MAX_ROOT_COMPLEX; RCIndex++) {
+    RootComplex = &RootComplexList[RCIndex];
+    if (!RootComplex->Active) {
+      continue;
+    }
+
+    for (PcieIndex = 0; PcieIndex < RootComplex->MaxPcieController; PcieIndex++) {
+      Pcie = &RootComplex->Pcie[PcieIndex];
+      if (!Pcie->Active || Pcie->LinkUp) {
+        continue;
+      }
+
+      if (!PcieLinkUpCheck (Pcie)) {
+        // Still training, or retraining through Recovery
+        AllLinkUp = FALSE;
+        continue;
+      }
+
+      if (LinkUpTime[RCIndex][PcieIndex] == 0) {
+        LinkUpTime[RCIndex][PcieIndex] = MAX (ElapsedUs, 1);
+        DEBUG ((
+          DEBUG_INFO,
+          "S%d-PCIE%d.%d reached L0 after %dus\n",
+          RootComplex->Socket,
+          RootComplex->ID,
+          PcieIndex,
+          ElapsedUs
+          ));
+      }
+
+      if (!Ac01PcieCoreLinkAtMaxCapability (RootComplex, PcieIndex) &&
+          (ElapsedUs < LinkUpTime[RCIndex][PcieIndex] + LINK_SETTLE_TIMEOUT))
+      {
+        AllLinkUp = FALSE;
+      }
+    }
+  }
+
+  return AllLinkUp;
+}
+
 /**
   Verify the link status and retry to initialize the Root Complex if there's any issue.
 
@@ -1812,14 +1915,18 @@ Ac01PcieCorePostSetupRC (
   BOOLEAN  IsNextRoundNeeded, NextRoundNeeded;
   UINT64   PrevTick, CurrTick, ElapsedCycle;
   UINT64   TimerTicks64;
+  UINT32   ElapsedUs;
   UINT8    ReInit;
   INT8     FailedPciePtr[MaxPcieControllerOfRootComplexB];
   INT8     FailedPcieCount;
+  UINT32   LinkUpTime[AC01_PCIE_MAX_ROOT_COMPLEX][MaxPcieControllerOfRootComplexB];
 
   ReInit = 0;
 
 _link_polling:
   NextRoundNeeded = FALSE;
+  SetMem ((VOID *)LinkUpTime, sizeof (LinkUpTime), 0);
+
   //
   // It is not guaranteed the timer service is ready prior to PCI Dxe.
   // Calculate system ticks for link training.
@@ -1828,6 +1935,12 @@ _link_polling:
   PrevTick     = ArmGenericTimerGetSystemCount ();
   ElapsedCycle = 0;
 
+  //
+  // Service all training links in a single loop and stop as soon as every
+  // active controller has settled in L0 at its target speed and width,
+  // instead of always waiting the full second. Links which do not come up
+  // or do not settle still get the whole budget.
+  //
   do {
     CurrTick = ArmGenericTimerGetSystemCount ();
     if (CurrTick < PrevTick) {
@@ -1837,8 +1950,17 @@ _link_polling:
 
     ElapsedCycle += (CurrTick - PrevTick);
     PrevTick      = CurrTick;
+
+    ElapsedUs = (UINT32)DivU64x64Remainder (MultU64x32 (ElapsedCycle, 1000000), TimerTicks64, NULL);
+    if (Ac01PcieCorePollLinks (RootComplexList, ElapsedUs, LinkUpTime)) {
+      break;
+    }
+
+    MicroSecondDelay (LINK_WAIT_INTERVAL_US);
   } while (ElapsedCycle < TimerTicks64);
 
+  DEBUG ((DEBUG_INFO, "PCIe link training round %d took %dus\n", ReInit, ElapsedUs));
+
   for (RCIndex = 0; RCIndex < AC01_PCIE_MAX_ROOT_COMPLEX; RCIndex++) {
     Ac01PcieCoreUpdateLink (&RootComplexList[RCIndex], &IsNextRoundNeeded, FailedPciePtr, &FailedPcieCount);
     if (IsNextRoundNeeded) {
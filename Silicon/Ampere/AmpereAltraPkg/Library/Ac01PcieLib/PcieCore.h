@@ -41,6 +41,7 @@
 #define EP_LINKUP_TIMEOUT         (10 * 1000)        // 10ms
 #define EP_LINKUP_EXTRA_TIMEOUT   (500 * 1000)       // 500ms
 #define LINK_WAIT_INTERVAL_US     50
+#define LINK_SETTLE_TIMEOUT       (200 * 1000)       // 200ms after first L0
 
 #define PFA_MODE_ENABLE  0
 #define PFA_MODE_CLEAR   1
@@ -803,6 +803,10 @@ GenetRxComplete (
   IN GENET_PRIVATE_DATA *Genet
   )
 {
+  // The RX buffer stays mapped, so hand the descriptor straight back.
+  GenetMmioWrite (Genet,
+    GENET_RX_DESC_STATUS (Genet->RxConsIndex % GENET_DMA_DESC_COUNT), 0);
+
   Genet->RxConsIndex = (Genet->RxConsIndex + 1) & 0xFFFF;
   GenetMmioWrite (Genet, GENET_RX_DMA_CONS_INDEX (GENET_DMA_DEFAULT_QUEUE),
                   Genet->RxConsIndex);
@@ -10,6 +10,7 @@
 
 #include <Uefi.h>
 #include <Library/BaseMemoryLib.h>
+#include <Library/CacheMaintenanceLib.h>
 #include <Library/DebugLib.h>
 #include <Library/DmaLib.h>
 #include <Library/NetLib.h>
@@ -762,9 +763,13 @@ GenetSimpleNetworkReceive (
 
   ASSERT (Genet->RxBufferMap[DescIndex].Mapping != NULL);
 
-  GenetDmaUnmapRxDescriptor (Genet, DescIndex);
-
+  //
+  // RX buffers stay mapped for the lifetime of the ring. The CPU never
+  // writes to them, so only the lines the controller just filled need to
+  // be invalidated before the frame is read.
+  //
   Frame = GENET_RX_BUFFER (Genet, DescIndex);
+  InvalidateDataCacheRange (Frame, MIN (FrameLength, GENET_MAX_PACKET_SIZE));
 
   if (FrameLength > 2 + Genet->SnpMode.MediaHeaderSize) {
     // Received frame has 2 bytes of padding at the start
@@ -803,11 +808,6 @@ GenetSimpleNetworkReceive (
   }
 
 out:
-  Status = GenetDmaMapRxDescriptor (Genet, DescIndex);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "%a: Failed to remap RX descriptor!\n", __func__));
-  }
-
   GenetRxComplete (Genet);
 
   EfiReleaseLock (&Genet->Lock);
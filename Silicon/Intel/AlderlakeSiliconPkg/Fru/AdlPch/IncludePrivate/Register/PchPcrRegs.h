@@ -55,5 +55,6 @@ Conventions:
 #define PID_GPIOCOM2   0x6C
 #define PID_GPIOCOM4   0x6A
 #define PID_GPIOCOM5   0x69
+#define PID_RTC_HOST   0xC3
 
 #endif
@@ -41,4 +41,7 @@ Conventions:
 #define R_RTC_IO_EXT_INDEX_ALT                   0x76
 #define R_RTC_IO_REGD                            0x0D
 
+#define R_RTC_PCR_BUC                            0x3414    ///< Backed Up Control
+#define B_RTC_PCR_BUC_TS                         BIT0      ///< Top Swap
+
 #endif
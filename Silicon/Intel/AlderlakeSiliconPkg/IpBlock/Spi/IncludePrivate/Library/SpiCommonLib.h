@@ -41,6 +41,38 @@ typedef enum {
   FlashComponentMax
 } FLASH_COMPONENT_NUM;
 
+//
+// Flash read cache geometry. A line matches the 256 byte trimming boundary used
+// by the hardware sequencing cycles, so a line never spans two flash regions.
+//
+#define SPI_READ_CACHE_LINE_SIZE  256
+#define SPI_READ_CACHE_LINES      4
+
+//
+// Size of the BIOS region window decoded right below 4GB.
+//
+#define SPI_BIOS_MMIO_WINDOW_SIZE SIZE_16MB
+
+///
+/// Flash read cache line, tagged with the flash linear address of its first byte
+///
+typedef struct {
+  UINT32                Address;
+  BOOLEAN               Valid;
+  UINT8                 Data[SPI_READ_CACHE_LINE_SIZE];
+} SPI_READ_CACHE_LINE;
+
+///
+/// Flash read throughput counters
+///
+typedef struct {
+  UINT64                MmioReadBytes;        ///< Bytes copied from the memory mapped BIOS region
+  UINT64                CycleReadBytes;       ///< Bytes transferred through FDATA hardware sequencing cycles
+  UINT64                CycleReadCount;       ///< Number of hardware sequencing read cycles issued
+  UINT64                CacheHitBytes;        ///< Bytes served from the read cache
+  UINT64                CacheInvalidations;   ///< Cache lines dropped because of a write or erase
+} SPI_READ_STATISTICS;
+
 ///
 /// Private data structure definitions for the driver
 ///
@@ -63,6 +95,11 @@ typedef struct {
   UINT8                 NumberOfComponents;
   UINT32                Component1StartAddr;
   UINT32                TotalFlashSize;
+  UINT32                BiosRegionBase;
+  UINT32                BiosRegionSize;
+  SPI_READ_CACHE_LINE   ReadCache[SPI_READ_CACHE_LINES];
+  UINT8                 ReadCacheVictim;
+  SPI_READ_STATISTICS   ReadStatistics;
 } SPI_INSTANCE;
 
 #define SPI_INSTANCE_FROM_SPIPROTOCOL(a)  CR (a, SPI_INSTANCE, SpiProtocol, PCH_SPI_PRIVATE_DATA_SIGNATURE)
@@ -143,6 +180,16 @@ IsSpiFlashWriteGranted (
   VOID
   );
 
+/**
+  Print the flash read throughput counters of a SPI instance.
+
+  @param[in] SpiInstance          Pointer to SpiInstance
+**/
+VOID
+SpiDumpReadStatistics (
+  IN  SPI_INSTANCE                *SpiInstance
+  );
+
 /**
   Read data from the flash part.
 
@@ -9,6 +9,7 @@
 #include <Library/IoLib.h>
 #include <Library/DebugLib.h>
 #include <Library/BaseMemoryLib.h>
+#include <Library/CacheMaintenanceLib.h>
 #include <IndustryStandard/Pci30.h>
 #include <Library/PmcLib.h>
 #include <Library/PciSegmentLib.h>
@@ -18,7 +19,10 @@
 #include <Register/SpiRegs.h>
 #include <Register/FlashRegs.h>
 #include <Register/PmcRegs.h>
+#include <Register/RtcRegs.h>
+#include <Register/PchPcrRegs.h>
 #include <Library/PchPciBdfLib.h>
+#include <Library/PchPcrLib.h>
 #include <Library/SpiAccessLib.h>
 
 #define DEFAULT_CPU_STRAP_BASE_OFFSET 0x300 // Default CPU Straps base offset
@@ -315,9 +319,134 @@ SpiProtocolConstructor (
   DEBUG ((DEBUG_INFO, "CpuStrapBaseAddr : %0x\n", SpiInstance->CpuStrapBaseAddr));
   DEBUG ((DEBUG_INFO, "CpuStrapSize : %0x\n", SpiInstance->CpuStrapSize));
 
+  //
+  // Keep the BIOS region location so reads falling in the memory mapped
+  // BIOS window can bypass the hardware sequencing cycles.
+  //
+  Status = SpiProtocolGetRegionAddress (
+             &(SpiInstance->SpiProtocol),
+             &gFlashRegionBiosGuid,
+             &SpiInstance->BiosRegionBase,
+             &SpiInstance->BiosRegionSize
+             );
+  if (EFI_ERROR (Status)) {
+    SpiInstance->BiosRegionBase = 0;
+    SpiInstance->BiosRegionSize = 0;
+  }
+  DEBUG ((DEBUG_INFO, "BiosRegionBase : %0x\n", SpiInstance->BiosRegionBase));
+  DEBUG ((DEBUG_INFO, "BiosRegionSize : %0x\n", SpiInstance->BiosRegionSize));
+
   return EFI_SUCCESS;
 }
 
+/**
+  Print the flash read throughput counters of a SPI instance.
+
+  @param[in] SpiInstance          Pointer to SpiInstance
+**/
+VOID
+SpiDumpReadStatistics (
+  IN  SPI_INSTANCE                *SpiInstance
+  )
+{
+  SPI_READ_STATISTICS   *Statistics;
+
+  Statistics = &SpiInstance->ReadStatistics;
+  DEBUG ((DEBUG_INFO, "SPI read statistics:\n"));
+  DEBUG ((DEBUG_INFO, "  MMIO bytes         : %ld\n", Statistics->MmioReadBytes));
+  DEBUG ((DEBUG_INFO, "  Cycle bytes        : %ld\n", Statistics->CycleReadBytes));
+  DEBUG ((DEBUG_INFO, "  Cycle count        : %ld\n", Statistics->CycleReadCount));
+  DEBUG ((DEBUG_INFO, "  Cache hit bytes    : %ld\n", Statistics->CacheHitBytes));
+  DEBUG ((DEBUG_INFO, "  Cache invalidations: %ld\n", Statistics->CacheInvalidations));
+}
+
+/**
+  Translate a flash linear address range to its memory mapped BIOS address.
+
+  Only the top SPI_BIOS_MMIO_WINDOW_SIZE bytes of the BIOS region are decoded,
+  with the end of the BIOS region mapped right below 4GB.
+
+  @param[in]  SpiInstance         Pointer to SpiInstance
+  @param[in]  HardwareSpiAddr     Flash linear address of the first byte
+  @param[in]  ByteCount           Number of bytes in the range
+  @param[out] MmioAddress         Memory mapped address of the first byte
+
+  @retval TRUE                    The whole range is memory mapped.
+  @retval FALSE                   The range must be accessed with hardware sequencing cycles.
+**/
+STATIC
+BOOLEAN
+SpiGetBiosMmioAddress (
+  IN     SPI_INSTANCE       *SpiInstance,
+  IN     UINT32             HardwareSpiAddr,
+  IN     UINT32             ByteCount,
+  OUT    UINTN              *MmioAddress
+  )
+{
+  UINT32  BiosRegionLimit;
+
+  if (SpiInstance->BiosRegionSize == 0) {
+    return FALSE;
+  }
+
+  BiosRegionLimit = SpiInstance->BiosRegionBase + SpiInstance->BiosRegionSize;
+  if ((HardwareSpiAddr < SpiInstance->BiosRegionBase) ||
+      (ByteCount > BiosRegionLimit - HardwareSpiAddr) ||
+      ((BiosRegionLimit - HardwareSpiAddr) > SPI_BIOS_MMIO_WINDOW_SIZE)) {
+    return FALSE;
+  }
+
+  *MmioAddress = (UINTN) (BASE_4GB - (BiosRegionLimit - HardwareSpiAddr));
+  return TRUE;
+}
+
+/**
+  Check whether Top Swap is active.
+
+  With BUC.TS set the top swap block of the memory mapped BIOS window aliases
+  the other copy, so the window no longer matches the flash linear addresses.
+
+  @retval TRUE                    Top Swap is set.
+  @retval FALSE                   Top Swap is clear.
+**/
+STATIC
+BOOLEAN
+SpiIsTopSwapEnabled (
+  VOID
+  )
+{
+  return (PchPcrRead8 (PID_RTC_HOST, R_RTC_PCR_BUC) & B_RTC_PCR_BUC_TS) != 0;
+}
+
+/**
+  Drop the read cache lines overlapping a flash linear address range.
+
+  @param[in] SpiInstance          Pointer to SpiInstance
+  @param[in] HardwareSpiAddr      Flash linear address of the first byte
+  @param[in] ByteCount            Number of bytes in the range
+**/
+STATIC
+VOID
+SpiInvalidateReadCache (
+  IN     SPI_INSTANCE       *SpiInstance,
+  IN     UINT32             HardwareSpiAddr,
+  IN     UINT32             ByteCount
+  )
+{
+  UINTN                 Index;
+  SPI_READ_CACHE_LINE   *Line;
+
+  for (Index = 0; Index < SPI_READ_CACHE_LINES; Index++) {
+    Line = &SpiInstance->ReadCache[Index];
+    if (Line->Valid &&
+        (Line->Address < HardwareSpiAddr + ByteCount) &&
+        (HardwareSpiAddr < Line->Address + SPI_READ_CACHE_LINE_SIZE)) {
+      Line->Valid = FALSE;
+      SpiInstance->ReadStatistics.CacheInvalidations++;
+    }
+  }
+}
+
 /**
   Delay for at least the request number of microseconds for Runtime usage.
 
@@ -472,6 +601,9 @@ SendSpiCmd (
   UINT32          SmiEnSave;
   UINT16          ABase;
   UINT32          HsfstsCtl;
+  UINT32          StartSpiAddr;
+  UINT32          TotalByteCount;
+  UINTN           MmioAddress;
 
   //
   // For flash write, there is a requirement that all CPU threads are in SMM
@@ -487,6 +619,8 @@ SendSpiCmd (
   SpiInstance       = SPI_INSTANCE_FROM_SPIPROTOCOL (This);
   SpiBaseAddress    = SpiInstance->PchSpiBase;
   ABase             = SpiInstance->PchAcpiBase;
+  TotalByteCount    = 0;
+  StartSpiAddr      = 0;
 
   //
   // Disable SMIs to make sure normal mode flash access is not interrupted by an SMI
@@ -552,6 +686,8 @@ SendSpiCmd (
     Status = EFI_INVALID_PARAMETER;
     goto SendSpiCmdEnd;
   }
+  StartSpiAddr   = HardwareSpiAddr;
+  TotalByteCount = ByteCount;
 
   //
   // Check for PCH SPI hardware sequencing required commands
@@ -722,6 +858,8 @@ SendSpiCmd (
           *(UINT32 *) (Buffer + Index) = MmioRead32 (PchSpiBar0 + R_SPI_MEM_FDATA00 + Index);
         }
       }
+      SpiInstance->ReadStatistics.CycleReadBytes += SpiDataCount;
+      SpiInstance->ReadStatistics.CycleReadCount++;
     }
 
     HardwareSpiAddr += SpiDataCount;
@@ -735,6 +873,16 @@ SendSpiCmdEnd:
   //
   if ((FlashCycleType == FlashCycleWrite) ||
       (FlashCycleType == FlashCycleErase)) {
+    //
+    // Drop any stale copy of the modified range, including the range attempted
+    // by a failed cycle, from the read cache and the CPU caches.
+    //
+    if (TotalByteCount != 0) {
+      SpiInvalidateReadCache (SpiInstance, StartSpiAddr, TotalByteCount);
+      if (SpiGetBiosMmioAddress (SpiInstance, StartSpiAddr, TotalByteCount, &MmioAddress)) {
+        WriteBackInvalidateDataCacheRange ((VOID *) MmioAddress, TotalByteCount);
+      }
+    }
     EnableBiosWriteProtect ();
     PciSegmentAndThenOr8 (
       SpiBaseAddress + R_SPI_CFG_BC,
@@ -776,12 +924,46 @@ SpiProtocolFlashRead (
   OUT    UINT8              *Buffer
   )
 {
-  EFI_STATUS        Status;
+  EFI_STATUS            Status;
+  SPI_INSTANCE          *SpiInstance;
+  UINT32                HardwareSpiAddr;
+  UINT32                FlashRegionSize;
+  UINTN                 MmioAddress;
+  UINT32                LineAddress;
+  UINT32                LineOffset;
+  UINT32                Length;
+  UINTN                 Index;
+  SPI_READ_CACHE_LINE   *Line;
+
+  SpiInstance = SPI_INSTANCE_FROM_SPIPROTOCOL (This);
+
+  Status = SpiProtocolGetRegionAddress (This, FlashRegionGuid, &HardwareSpiAddr, &FlashRegionSize);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+  if ((Address > FlashRegionSize) || (ByteCount > FlashRegionSize - Address)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  HardwareSpiAddr += Address;
 
   //
-  // Sends the command to the SPI interface to execute.
+  // Reads within the memory mapped BIOS window are served by a plain copy,
+  // avoiding the 64 byte FDATA cycles altogether. The window cannot be trusted
+  // while Top Swap is set.
   //
-  Status = SendSpiCmd (
+  if (SpiGetBiosMmioAddress (SpiInstance, HardwareSpiAddr, ByteCount, &MmioAddress) &&
+      !SpiIsTopSwapEnabled ()) {
+    CopyMem (Buffer, (VOID *) MmioAddress, ByteCount);
+    SpiInstance->ReadStatistics.MmioReadBytes += ByteCount;
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Large reads stream straight into the caller's buffer with back to back
+  // hardware sequencing cycles, so they do not evict the cached lines.
+  //
+  if (ByteCount > SPI_READ_CACHE_LINE_SIZE) {
+    return SendSpiCmd (
              This,
              FlashRegionGuid,
              FlashCycleRead,
@@ -789,7 +971,59 @@ SpiProtocolFlashRead (
              ByteCount,
              Buffer
              );
-  return Status;
+  }
+
+  //
+  // Small reads of memory unmapped regions, e.g. descriptor and soft straps,
+  // go through the read cache one line at a time.
+  //
+  while (ByteCount > 0) {
+    LineAddress = HardwareSpiAddr & ~(SPI_READ_CACHE_LINE_SIZE - 1);
+    LineOffset  = HardwareSpiAddr - LineAddress;
+    Length      = MIN (ByteCount, SPI_READ_CACHE_LINE_SIZE - LineOffset);
+
+    Line = NULL;
+    for (Index = 0; Index < SPI_READ_CACHE_LINES; Index++) {
+      if (SpiInstance->ReadCache[Index].Valid &&
+          (SpiInstance->ReadCache[Index].Address == LineAddress)) {
+        Line = &SpiInstance->ReadCache[Index];
+        SpiInstance->ReadStatistics.CacheHitBytes += Length;
+        break;
+      }
+    }
+
+    if (Line == NULL) {
+      //
+      // Flash region limits are 4KB aligned, and lines are smaller (256 bytes)
+      // and naturally aligned, so a line never crosses a region boundary and
+      // filling a whole line never touches a region other than the one being
+      // read.
+      //
+      Line = &SpiInstance->ReadCache[SpiInstance->ReadCacheVictim];
+      SpiInstance->ReadCacheVictim = (UINT8) ((SpiInstance->ReadCacheVictim + 1) % SPI_READ_CACHE_LINES);
+      Line->Valid = FALSE;
+      Status = SendSpiCmd (
+                 This,
+                 &gFlashRegionAllGuid,
+                 FlashCycleRead,
+                 LineAddress,
+                 SPI_READ_CACHE_LINE_SIZE,
+                 Line->Data
+                 );
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+      Line->Address = LineAddress;
+      Line->Valid   = TRUE;
+    }
+
+    CopyMem (Buffer, &Line->Data[LineOffset], Length);
+    HardwareSpiAddr += Length;
+    Buffer          += Length;
+    ByteCount       -= Length;
+  }
+
+  return EFI_SUCCESS;
 }
 
 /**
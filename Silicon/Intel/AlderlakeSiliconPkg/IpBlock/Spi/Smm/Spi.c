@@ -15,6 +15,7 @@
 #include <Library/PciSegmentLib.h>
 #include <Protocol/Spi2.h>
 #include <Protocol/SmmCpu.h>
+#include <Protocol/SmmEndOfDxe.h>
 #include <Library/SpiCommonLib.h>
 #include <PchReservedResources.h>
 #include <Library/SmmPchPrivateLib.h>
@@ -51,6 +52,29 @@ GLOBAL_REMOVE_IF_UNREFERENCED UINT32                mPchSpiBar0RefCount;
 //
 GLOBAL_REMOVE_IF_UNREFERENCED UINT8                 mPchSpiSavedPciCmdReg;
 
+/**
+  SMM End Of Dxe event notification handler.
+
+  Prints the flash read throughput counters gathered during boot.
+
+  @param[in] Protocol   Points to the protocol's unique identifier.
+  @param[in] Interface  Points to the interface instance.
+  @param[in] Handle     The handle on which the interface was installed.
+
+  @retval EFI_SUCCESS   Notification handler runs successfully.
+**/
+EFI_STATUS
+EFIAPI
+SpiSmmEndOfDxeNotify (
+  IN CONST EFI_GUID  *Protocol,
+  IN VOID            *Interface,
+  IN EFI_HANDLE      Handle
+  )
+{
+  SpiDumpReadStatistics (mSpiInstance);
+  return EFI_SUCCESS;
+}
+
 /**
   <b>SPI Runtime SMM Module Entry Point</b>\n
   - <b>Introduction</b>\n
@@ -93,6 +117,7 @@ InstallPchSpi (
   )
 {
   EFI_STATUS  Status;
+  VOID        *Registration;
 
   //
   // Init PCH spi reserved MMIO address.
@@ -141,6 +166,14 @@ InstallPchSpi (
     return EFI_DEVICE_ERROR;
   }
 
+  DEBUG_CODE_BEGIN ();
+  gSmst->SmmRegisterProtocolNotify (
+           &gEfiSmmEndOfDxeProtocolGuid,
+           SpiSmmEndOfDxeNotify,
+           &Registration
+           );
+  DEBUG_CODE_END ();
+
   return EFI_SUCCESS;
 }
 
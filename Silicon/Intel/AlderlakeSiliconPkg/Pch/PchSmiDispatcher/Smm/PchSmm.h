@@ -420,6 +420,10 @@ VOID
 struct _DATABASE_RECORD {
   UINT32                        Signature;
   LIST_ENTRY                    Link;
+  ///
+  /// Link in the dispatch index bucket of the top level SMI_STS bit
+  ///
+  LIST_ENTRY                    IndexLink;
   BOOLEAN                       Processed;
   ///
   /// Status and Enable bit description
@@ -464,6 +468,7 @@ struct _DATABASE_RECORD {
 };
 
 #define DATABASE_RECORD_FROM_LINK(_record)  CR (_record, DATABASE_RECORD, Link, DATABASE_RECORD_SIGNATURE)
+#define DATABASE_RECORD_FROM_INDEX_LINK(_record)  CR (_record, DATABASE_RECORD, IndexLink, DATABASE_RECORD_SIGNATURE)
 #define DATABASE_RECORD_FROM_CHILDCONTEXT(_record)  CR (_record, DATABASE_RECORD, ChildContext, DATABASE_RECORD_SIGNATURE)
 
 ///
@@ -589,6 +594,22 @@ typedef struct {
   PROTOCOL_SIGNATURE \
   )
 
+///
+/// Dispatch index buckets. Records are indexed by the bit of their top level
+/// status in SMI_STS, records without such a status go to the last bucket.
+///
+#define PCH_SMM_STS_INDEX_OTHER   32
+#define PCH_SMM_STS_INDEX_COUNT   (PCH_SMM_STS_INDEX_OTHER + 1)
+
+///
+/// SMI latency counters of one dispatch index bucket, in CPU timestamp ticks
+///
+typedef struct {
+  UINT64                      Count;
+  UINT64                      TotalTicks;
+  UINT64                      MaxTicks;
+} PCH_SMM_SOURCE_LATENCY;
+
 ///
 /// Create private data for the protocols that we'll publish
 ///
@@ -597,6 +618,8 @@ typedef struct {
   EFI_HANDLE                  SmiHandle;
   EFI_HANDLE                  InstallMultProtHandle;
   PCH_SMM_QUALIFIED_PROTOCOL  Protocols[PCH_SMM_PROTOCOL_TYPE_MAX];
+  LIST_ENTRY                  StsIndex[PCH_SMM_STS_INDEX_COUNT];
+  PCH_SMM_SOURCE_LATENCY      Latency[PCH_SMM_STS_INDEX_COUNT];
 } PRIVATE_DATA;
 
 extern PRIVATE_DATA           mPrivateData;
@@ -619,6 +642,25 @@ SmmCoreInsertRecord (
   OUT EFI_HANDLE                        *DispatchHandle
   );
 
+/**
+  The internal function used to take a database record out of the database
+  and of the dispatch index. The record itself is not freed.
+
+  @param[in]  Record                    Record to remove from database.
+**/
+VOID
+SmmCoreRemoveRecord (
+  IN  DATABASE_RECORD                   *Record
+  );
+
+/**
+  Print the per source SMI latency counters collected by the dispatcher.
+**/
+VOID
+PchSmmDumpSmiLatency (
+  VOID
+  );
+
 /**
   Get the Sleep type
 
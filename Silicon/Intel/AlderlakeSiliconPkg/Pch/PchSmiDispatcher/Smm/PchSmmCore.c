@@ -26,6 +26,7 @@ GLOBAL_REMOVE_IF_UNREFERENCED UINT16                mTcoBaseAddr;
 GLOBAL_REMOVE_IF_UNREFERENCED BOOLEAN               mReadyToLock;
 GLOBAL_REMOVE_IF_UNREFERENCED BOOLEAN               mS3SusStart;
 GLOBAL_REMOVE_IF_UNREFERENCED UINT32                mNumOfRootPorts;
+GLOBAL_REMOVE_IF_UNREFERENCED BOOLEAN               mSmiLatencyDumped;
 
 GLOBAL_REMOVE_IF_UNREFERENCED PRIVATE_DATA          mPrivateData = {
   {
@@ -148,6 +149,29 @@ PchSmmCoreDispatcher (
 //
 // FUNCTIONS
 //
+/**
+  Get the dispatch index bucket of a SMI source description.
+
+  @param[in] SrcDesc              Pointer to the PCH SMI source description table
+
+  @retval                         Bit of the top level status in SMI_STS,
+                                  or PCH_SMM_STS_INDEX_OTHER if it has none.
+**/
+STATIC
+UINTN
+SmmCoreGetStsIndex (
+  CONST PCH_SMM_SOURCE_DESC   *SrcDesc
+  )
+{
+  if (!IS_BIT_DESC_NULL (SrcDesc->PmcSmiSts) &&
+      (SrcDesc->PmcSmiSts.Reg.Type == ACPI_ADDR_TYPE) &&
+      (SrcDesc->PmcSmiSts.Reg.Data.acpi == R_ACPI_IO_SMI_STS) &&
+      (SrcDesc->PmcSmiSts.Bit < PCH_SMM_STS_INDEX_OTHER)) {
+    return SrcDesc->PmcSmiSts.Bit;
+  }
+  return PCH_SMM_STS_INDEX_OTHER;
+}
+
 /**
   SMM ready to lock notification event handler.
 
@@ -220,6 +244,7 @@ InitializePchSmmDispatcher (
 {
   EFI_STATUS           Status;
   VOID                 *SmmReadyToLockRegistration;
+  UINTN                Index;
 
   mS3SusStart = FALSE;
 
@@ -246,9 +271,12 @@ InitializePchSmmDispatcher (
   Status = gSmst->SmiHandlerRegister (PchSmmCoreDispatcher, NULL, &mPrivateData.SmiHandle);
   ASSERT_EFI_ERROR (Status);
   //
-  // Initialize Callback DataBase
+  // Initialize Callback DataBase and its dispatch index
   //
   InitializeListHead (&mPrivateData.CallbackDataBase);
+  for (Index = 0; Index < PCH_SMM_STS_INDEX_COUNT; Index++) {
+    InitializeListHead (&mPrivateData.StsIndex[Index]);
+  }
 
   //
   // Enable SMIs on the PCH now that we have a callback
@@ -314,6 +342,12 @@ SmmCoreInsertRecord (
   //
   InsertTailList (&mPrivateData.CallbackDataBase, &Record->Link);
 
+  //
+  // Also add it to the dispatch index so the dispatcher only visits the records
+  // whose top level status bit is set.
+  //
+  InsertTailList (&mPrivateData.StsIndex[SmmCoreGetStsIndex (&Record->SrcDesc)], &Record->IndexLink);
+
   //
   // Child's handle will be the address linked list link in the record
   //
@@ -322,6 +356,54 @@ SmmCoreInsertRecord (
   return EFI_SUCCESS;
 }
 
+/**
+  The internal function used to take a database record out of the database
+  and of the dispatch index. The record itself is not freed.
+
+  @param[in]  Record                    Record to remove from database.
+**/
+VOID
+SmmCoreRemoveRecord (
+  IN  DATABASE_RECORD                   *Record
+  )
+{
+  RemoveEntryList (&Record->Link);
+  RemoveEntryList (&Record->IndexLink);
+}
+
+/**
+  Print the per source SMI latency counters collected by the dispatcher.
+**/
+VOID
+PchSmmDumpSmiLatency (
+  VOID
+  )
+{
+  UINTN                   Index;
+  PCH_SMM_SOURCE_LATENCY  *Latency;
+
+  DEBUG ((DEBUG_INFO, "PCH SMI latency (TSC ticks):\n"));
+  DEBUG ((DEBUG_INFO, "  SMI_STS bit   Count        Average      Max\n"));
+  for (Index = 0; Index < PCH_SMM_STS_INDEX_COUNT; Index++) {
+    Latency = &mPrivateData.Latency[Index];
+    if (Latency->Count == 0) {
+      continue;
+    }
+    if (Index == PCH_SMM_STS_INDEX_OTHER) {
+      DEBUG ((DEBUG_INFO, "  other"));
+    } else {
+      DEBUG ((DEBUG_INFO, "  %5d", (UINT32) Index));
+    }
+    DEBUG ((
+      DEBUG_INFO,
+      "         %-12ld %-12ld %ld\n",
+      Latency->Count,
+      DivU64x64Remainder (Latency->TotalTicks, Latency->Count, NULL),
+      Latency->MaxTicks
+      ));
+  }
+}
+
 /**
   Unregister a child SMI source dispatch function with a parent SMM driver
 
@@ -586,7 +668,7 @@ PchSmmCoreUnRegister (
     return EFI_INVALID_PARAMETER;
   }
 
-  RemoveEntryList (&RecordToDelete->Link);
+  SmmCoreRemoveRecord (RecordToDelete);
 
   //
   // Loop through all the souces in record linked list to see if any source enable is equal.
@@ -664,6 +746,60 @@ ClearPendingSmiStatus (
   }
 }
 
+/**
+  Look up the first active SMI source through the dispatch index.
+
+  Only the buckets whose bit is set in SMI_STS are visited, followed by the
+  records that have no top level status bit in SMI_STS.
+
+  @param[in]  SciEn                     Current SCI_EN value
+  @param[in]  SmiEnValue                Current SMI_EN value
+  @param[in]  SmiStsValue               Current SMI_STS value
+  @param[out] StsIndex                  Bucket of the returned record
+
+  @retval NULL                          No registered source is active
+  @retval Other                         First record whose source is active
+**/
+STATIC
+DATABASE_RECORD *
+SmmCoreFindActiveRecord (
+  IN  BOOLEAN                           SciEn,
+  IN  UINT32                            SmiEnValue,
+  IN  UINT32                            SmiStsValue,
+  OUT UINTN                             *StsIndex
+  )
+{
+  UINT32                                PendingSts;
+  UINTN                                 Index;
+  LIST_ENTRY                            *Bucket;
+  LIST_ENTRY                            *LinkInDb;
+  DATABASE_RECORD                       *RecordInDb;
+
+  PendingSts = SmiStsValue;
+  Index      = 0;
+  while (TRUE) {
+    if (PendingSts != 0) {
+      Index       = (UINTN) LowBitSet32 (PendingSts);
+      PendingSts &= PendingSts - 1;
+    } else if (Index != PCH_SMM_STS_INDEX_OTHER) {
+      Index = PCH_SMM_STS_INDEX_OTHER;
+    } else {
+      return NULL;
+    }
+
+    Bucket   = &mPrivateData.StsIndex[Index];
+    LinkInDb = GetFirstNode (Bucket);
+    while (!IsNull (Bucket, LinkInDb)) {
+      RecordInDb = DATABASE_RECORD_FROM_INDEX_LINK (LinkInDb);
+      if (SourceIsActive (&RecordInDb->SrcDesc, SciEn, SmiEnValue, SmiStsValue)) {
+        *StsIndex = Index;
+        return RecordInDb;
+      }
+      LinkInDb = GetNextNode (Bucket, LinkInDb);
+    }
+  }
+}
+
 /**
   The callback function to handle subsequent SMIs.  This callback will be called by SmmCoreDispatcher.
 
@@ -692,9 +828,14 @@ PchSmmCoreDispatcher (
   BOOLEAN             EosSet;
 
   DATABASE_RECORD     *RecordInDb;
-  LIST_ENTRY          *LinkInDb;
   DATABASE_RECORD     *RecordToExhaust;
   LIST_ENTRY          *LinkToExhaust;
+  UINTN               StsIndex;
+  PCH_SMM_CLEAR_SOURCE  ClearSource;
+
+  PCH_SMM_SOURCE_LATENCY  *Latency;
+  UINT64                  StartTicks;
+  UINT64                  ElapsedTicks;
 
   PCH_SMM_CONTEXT     Context;
   VOID                *CommBuffer;
@@ -735,8 +876,6 @@ PchSmmCoreDispatcher (
     while ((!EosSet) && (EscapeCount > 0)) {
       EscapeCount--;
 
-      LinkInDb = GetFirstNode (&mPrivateData.CallbackDataBase);
-
       //
       // Cache SciEn, SmiEnValue and SmiStsValue to determine if source is active
       //
@@ -744,141 +883,149 @@ PchSmmCoreDispatcher (
       SmiEnValue  = IoRead32 ((UINTN) (mAcpiBaseAddr + R_ACPI_IO_SMI_EN));
       SmiStsValue = IoRead32 ((UINTN) (mAcpiBaseAddr + R_ACPI_IO_SMI_STS));
 
-      while (!IsNull (&mPrivateData.CallbackDataBase, LinkInDb)) {
-        RecordInDb = DATABASE_RECORD_FROM_LINK (LinkInDb);
+      //
+      // look for the first active source
+      //
+      RecordInDb = SmmCoreFindActiveRecord (SciEn, SmiEnValue, SmiStsValue, &StsIndex);
+      if (RecordInDb == NULL) {
+        //
+        // Clear pending SMI status before EOS
+        //
+        ClearPendingSmiStatus (SmiStsValue, SciEn);
+        EosSet = PchSmmSetAndCheckEos ();
+        continue;
+      }
+
+      StartTicks = AsmReadTsc ();
+
+      //
+      // "cache" the source description and don't query I/O anymore
+      //
+      CopyMem ((VOID *) &ActiveSource, (VOID *) &(RecordInDb->SrcDesc), sizeof (PCH_SMM_SOURCE_DESC));
+      ClearSource   = RecordInDb->ClearSource;
+      LinkToExhaust = &RecordInDb->IndexLink;
 
+      //
+      // exhaust the rest of the bucket looking for the same source. CompareSources
+      // includes PmcSmiSts, so records with an equal source description always
+      // share the same bucket.
+      //
+      while (!IsNull (&mPrivateData.StsIndex[StsIndex], LinkToExhaust)) {
+        RecordToExhaust = DATABASE_RECORD_FROM_INDEX_LINK (LinkToExhaust);
         //
-        // look for the first active source
+        // RecordToExhaust->IndexLink might be removed (unregistered) by Callback function, and then the
+        // system will hang in ASSERT() while calling GetNextNode().
+        // To prevent the issue, we need to get next record in the bucket here (before Callback function).
         //
-        if (!SourceIsActive (&RecordInDb->SrcDesc, SciEn, SmiEnValue, SmiStsValue)) {
-          //
-          // Didn't find the source yet, keep looking
-          //
-          LinkInDb = GetNextNode (&mPrivateData.CallbackDataBase, &RecordInDb->Link);
+        LinkToExhaust = GetNextNode (&mPrivateData.StsIndex[StsIndex], &RecordToExhaust->IndexLink);
 
+        if (CompareSources (&RecordToExhaust->SrcDesc, &ActiveSource)) {
           //
-          // if it's the last one, try to clear EOS
+          // These source descriptions are equal, so this callback should be
+          // dispatched.
           //
-          if (IsNull (&mPrivateData.CallbackDataBase, LinkInDb)) {
+          if (RecordToExhaust->ContextFunctions.GetContext != NULL) {
             //
-            // Clear pending SMI status before EOS
+            // This child requires that we get a calling context from
+            // hardware and compare that context to the one supplied
+            // by the child.
             //
-            ClearPendingSmiStatus (SmiStsValue, SciEn);
-            EosSet = PchSmmSetAndCheckEos ();
-          }
-        } else {
-          //
-          // "cache" the source description and don't query I/O anymore
-          //
-          CopyMem ((VOID *) &ActiveSource, (VOID *) &(RecordInDb->SrcDesc), sizeof (PCH_SMM_SOURCE_DESC));
-          LinkToExhaust = LinkInDb;
+            ASSERT (RecordToExhaust->ContextFunctions.CmpContext != NULL);
 
-          //
-          // exhaust the rest of the queue looking for the same source
-          //
-          while (!IsNull (&mPrivateData.CallbackDataBase, LinkToExhaust)) {
-            RecordToExhaust = DATABASE_RECORD_FROM_LINK (LinkToExhaust);
             //
-            // RecordToExhaust->Link might be removed (unregistered) by Callback function, and then the
-            // system will hang in ASSERT() while calling GetNextNode().
-            // To prevent the issue, we need to get next record in DB here (before Callback function).
+            // Make sure contexts match before dispatching event to child
             //
-            LinkToExhaust = GetNextNode (&mPrivateData.CallbackDataBase, &RecordToExhaust->Link);
+            RecordToExhaust->ContextFunctions.GetContext (RecordToExhaust, &Context);
+            ContextsMatch = RecordToExhaust->ContextFunctions.CmpContext (&Context, &RecordToExhaust->ChildContext);
 
-            if (CompareSources (&RecordToExhaust->SrcDesc, &ActiveSource)) {
+          } else {
+            //
+            // This child doesn't require any more calling context beyond what
+            // it supplied in registration.  Simply pass back what it gave us.
+            //
+            Context       = RecordToExhaust->ChildContext;
+            ContextsMatch = TRUE;
+          }
+
+          if (ContextsMatch) {
+            if (RecordToExhaust->ProtocolType == PchSmiDispatchType) {
               //
-              // These source descriptions are equal, so this callback should be
-              // dispatched.
+              // For PCH SMI dispatch protocols
               //
-              if (RecordToExhaust->ContextFunctions.GetContext != NULL) {
-                //
-                // This child requires that we get a calling context from
-                // hardware and compare that context to the one supplied
-                // by the child.
-                //
-                ASSERT (RecordToExhaust->ContextFunctions.CmpContext != NULL);
-
-                //
-                // Make sure contexts match before dispatching event to child
-                //
-                RecordToExhaust->ContextFunctions.GetContext (RecordToExhaust, &Context);
-                ContextsMatch = RecordToExhaust->ContextFunctions.CmpContext (&Context, &RecordToExhaust->ChildContext);
-
-              } else {
+              PchSmiTypeCallbackDispatcher (RecordToExhaust);
+            } else {
+              if ((RecordToExhaust->ProtocolType == SxType) && (Context.Sx.Type == SxS3) && (Context.Sx.Phase == SxEntry) && !mS3SusStart) {
+                REPORT_STATUS_CODE (EFI_PROGRESS_CODE, PROGRESS_CODE_S3_SUSPEND_START);
+                mS3SusStart = TRUE;
+              }
+              if ((RecordToExhaust->ProtocolType == SxType) && (Context.Sx.Phase == SxEntry) && !mSmiLatencyDumped) {
                 //
-                // This child doesn't require any more calling context beyond what
-                // it supplied in registration.  Simply pass back what it gave us.
+                // Dump the SMI latency collected so far before the platform goes to sleep
                 //
-                Context       = RecordToExhaust->ChildContext;
-                ContextsMatch = TRUE;
+                PchSmmDumpSmiLatency ();
+                mSmiLatencyDumped = TRUE;
               }
-
-              if (ContextsMatch) {
-                if (RecordToExhaust->ProtocolType == PchSmiDispatchType) {
+              //
+              // For EFI standard SMI dispatch protocols
+              //
+              if (RecordToExhaust->Callback != NULL) {
+                if (RecordToExhaust->ContextFunctions.GetCommBuffer != NULL) {
                   //
-                  // For PCH SMI dispatch protocols
+                  // This callback function needs CommBuffer and CommBufferSize.
+                  // Get those from child and then pass to callback function.
                   //
-                  PchSmiTypeCallbackDispatcher (RecordToExhaust);
+                  RecordToExhaust->ContextFunctions.GetCommBuffer (RecordToExhaust, &CommBuffer, &CommBufferSize);
                 } else {
-                  if ((RecordToExhaust->ProtocolType == SxType) && (Context.Sx.Type == SxS3) && (Context.Sx.Phase == SxEntry) && !mS3SusStart) {
-                    REPORT_STATUS_CODE (EFI_PROGRESS_CODE, PROGRESS_CODE_S3_SUSPEND_START);
-                    mS3SusStart = TRUE;
-                  }
                   //
-                  // For EFI standard SMI dispatch protocols
+                  // Child doesn't support the CommBuffer and CommBufferSize.
+                  // Just pass NULL value to callback function.
                   //
-                  if (RecordToExhaust->Callback != NULL) {
-                    if (RecordToExhaust->ContextFunctions.GetCommBuffer != NULL) {
-                      //
-                      // This callback function needs CommBuffer and CommBufferSize.
-                      // Get those from child and then pass to callback function.
-                      //
-                      RecordToExhaust->ContextFunctions.GetCommBuffer (RecordToExhaust, &CommBuffer, &CommBufferSize);
-                    } else {
-                      //
-                      // Child doesn't support the CommBuffer and CommBufferSize.
-                      // Just pass NULL value to callback function.
-                      //
-                      CommBuffer     = NULL;
-                      CommBufferSize = 0;
-                    }
-
-                    PERF_START_EX (NULL, "SmmFunction", NULL, AsmReadTsc (), RecordToExhaust->ProtocolType);
-                    RecordToExhaust->Callback ((EFI_HANDLE) & RecordToExhaust->Link, &Context, CommBuffer, &CommBufferSize);
-                    PERF_END_EX (NULL, "SmmFunction", NULL, AsmReadTsc (), RecordToExhaust->ProtocolType);
-                  } else {
-                    ASSERT (FALSE);
-                  }
+                  CommBuffer     = NULL;
+                  CommBufferSize = 0;
                 }
+
+                PERF_START_EX (NULL, "SmmFunction", NULL, AsmReadTsc (), RecordToExhaust->ProtocolType);
+                RecordToExhaust->Callback ((EFI_HANDLE) & RecordToExhaust->Link, &Context, CommBuffer, &CommBufferSize);
+                PERF_END_EX (NULL, "SmmFunction", NULL, AsmReadTsc (), RecordToExhaust->ProtocolType);
+              } else {
+                ASSERT (FALSE);
               }
             }
           }
-
-          if (RecordInDb->ClearSource == NULL) {
-            //
-            // Clear the SMI associated w/ the source using the default function
-            //
-            PchSmmClearSource (&ActiveSource);
-          } else {
-            //
-            // This source requires special handling to clear
-            //
-            RecordInDb->ClearSource (&ActiveSource);
-          }
-          //
-          // Clear pending SMI status before EOS
-          //
-          ClearPendingSmiStatus (SmiStsValue, SciEn);
-          //
-          // Also, try to clear EOS
-          //
-          EosSet = PchSmmSetAndCheckEos ();
-          //
-          // Queue is empty, reset the search
-          //
-          break;
         }
       }
+
+      if (ClearSource == NULL) {
+        //
+        // Clear the SMI associated w/ the source using the default function
+        //
+        PchSmmClearSource (&ActiveSource);
+      } else {
+        //
+        // This source requires special handling to clear
+        //
+        ClearSource (&ActiveSource);
+      }
+
+      //
+      // Account the time spent dispatching this source
+      //
+      Latency = &mPrivateData.Latency[StsIndex];
+      ElapsedTicks = AsmReadTsc () - StartTicks;
+      Latency->Count++;
+      Latency->TotalTicks += ElapsedTicks;
+      if (ElapsedTicks > Latency->MaxTicks) {
+        Latency->MaxTicks = ElapsedTicks;
+      }
+
+      //
+      // Clear pending SMI status before EOS
+      //
+      ClearPendingSmiStatus (SmiStsValue, SciEn);
+      //
+      // Also, try to clear EOS
+      //
+      EosSet = PchSmmSetAndCheckEos ();
     }
   }
   //
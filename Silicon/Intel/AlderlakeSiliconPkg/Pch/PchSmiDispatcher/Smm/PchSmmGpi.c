@@ -235,7 +235,7 @@ PchGpiSmiUnRegister (
   }
 
 
-  RemoveEntryList (&RecordToDelete->Link);
+  SmmCoreRemoveRecord (RecordToDelete);
   ZeroMem (RecordToDelete, sizeof (DATABASE_RECORD));
   Status = gSmst->SmmFreePool (RecordToDelete);
 
@@ -127,7 +127,8 @@ CompareStatuses (
 }
 
 /**
-  Compare 2 SMM source descriptors, based on Enable settings and Status settings of them.
+  Compare 2 SMM source descriptors, based on Enable settings, Status settings and
+  the top level PMC SMI_STS bit of them.
 
   @param[in] Src1                 Pointer to the PCH SMI source description table 1
   @param[in] Src2                 Pointer to the PCH SMI source description table 2
@@ -141,7 +142,15 @@ CompareSources (
   CONST IN PCH_SMM_SOURCE_DESC *Src2
   )
 {
-  return (BOOLEAN) (CompareEnables (Src1, Src2) && CompareStatuses (Src1, Src2));
+  ///
+  /// The dispatcher buckets records by PmcSmiSts, so it is part of the identity
+  /// of a source. Equal sources then always share the same dispatch bucket.
+  ///
+  return (BOOLEAN) (CompareEnables (Src1, Src2) &&
+                    CompareStatuses (Src1, Src2) &&
+                    (Src1->PmcSmiSts.Bit == Src2->PmcSmiSts.Bit) &&
+                    (Src1->PmcSmiSts.Reg.Type == Src2->PmcSmiSts.Reg.Type) &&
+                    (Src1->PmcSmiSts.Reg.Data.raw == Src2->PmcSmiSts.Reg.Data.raw));
 }
 
 /**
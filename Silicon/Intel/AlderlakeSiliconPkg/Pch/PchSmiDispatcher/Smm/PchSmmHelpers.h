@@ -70,7 +70,8 @@ CompareStatuses (
   );
 
 /**
-  Compare 2 SMM source descriptors, based on Enable settings and Status settings of them.
+  Compare 2 SMM source descriptors, based on Enable settings, Status settings and
+  the top level PMC SMI_STS bit of them.
 
   @param[in] Src1                 Pointer to the PCH SMI source description table 1
   @param[in] Src2                 Pointer to the PCH SMI source description table 2
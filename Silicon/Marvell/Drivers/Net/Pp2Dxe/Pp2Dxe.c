@@ -98,7 +98,7 @@ EFI_SIMPLE_NETWORK_MODE Pp2SnpModeTemplate = {
   },                                                    // Permanent Address
   NET_IFTYPE_ETHERNET,                                  // IfType
   TRUE,                                                 // MacAddressChangeable
-  FALSE,                                                // MultipleTxSupported
+  TRUE,                                                 // MultipleTxSupported
   TRUE,                                                 // MediaPresentSupported
   FALSE                                                 // MediaPresent
 };
@@ -142,6 +142,52 @@ QueueRemove (
   return Buffer;
 }
 
+STATIC
+UINTN
+QueueCount (
+  IN PP2DXE_CONTEXT *Pp2Context
+  )
+{
+  return (Pp2Context->CompletionQueueTail + QUEUE_DEPTH -
+          Pp2Context->CompletionQueueHead) % QUEUE_DEPTH;
+}
+
+/*
+ * Move the oldest in-flight TX buffers to the completion queue.
+ * Reading the per-port sent counter clears it, so a single read reaps
+ * every frame the hardware completed since the previous call.
+ */
+STATIC
+VOID
+Pp2DxeTxReap (
+  IN PP2DXE_CONTEXT *Pp2Context,
+  IN BOOLEAN        All
+  )
+{
+  PP2DXE_PORT *Port = &Pp2Context->Port;
+  INTN TxSent;
+
+  if (Pp2Context->TxInFlightCount == 0) {
+    return;
+  }
+
+  if (All) {
+    /* Drop the HW count too, so it cannot be matched to later frames */
+    Mvpp2TxqSentDescProc(Port, &Port->Txqs[0]);
+    TxSent = (INTN)Pp2Context->TxInFlightCount;
+  } else {
+    TxSent = Mvpp2TxqSentDescProc(Port, &Port->Txqs[0]);
+  }
+
+  while (TxSent-- > 0 && Pp2Context->TxInFlightCount > 0) {
+    /* Transmit keeps in-flight plus completed buffers below QUEUE_DEPTH */
+    QueueInsert (Pp2Context, Pp2Context->TxInFlight[Pp2Context->TxInFlightHead]);
+    Pp2Context->TxInFlight[Pp2Context->TxInFlightHead] = NULL;
+    Pp2Context->TxInFlightHead = (Pp2Context->TxInFlightHead + 1) % MVPP2_MAX_TXD;
+    Pp2Context->TxInFlightCount--;
+  }
+}
+
 STATIC
 EFI_STATUS
 Pp2DxeBmPoolInit (
@@ -753,6 +799,9 @@ Pp2SnpShutdown (
 
   Pp2DxeHalt (Pp2Context);
 
+  /* Frames still queued were dropped with the port, hand the buffers back */
+  Pp2DxeTxReap (Pp2Context, TRUE);
+
   This->Mode->State = EfiSimpleNetworkStarted;
 
   ReturnUnlock (SavedTpl, EFI_SUCCESS);
@@ -1063,6 +1112,8 @@ Pp2SnpGetStatus (
   }
   Snp->Mode->MediaPresent = LinkUp;
 
+  Pp2DxeTxReap (Pp2Context, FALSE);
+
   if (TxBuf != NULL) {
     *TxBuf = QueueRemove (Pp2Context);
   }
@@ -1087,9 +1138,8 @@ Pp2SnpTransmit (
   MVPP2_SHARED *Mvpp2Shared = Pp2Context->Port.Priv;
   MVPP2_TX_QUEUE *AggrTxq = Mvpp2Shared->AggrTxqs;
   MVPP2_TX_DESC *TxDesc;
-  EFI_STATUS Status;
   INTN PollingCount;
-  INTN TxSent;
+  UINTN Slot;
   UINT8 *DataPtr = Buffer;
   UINT16 EtherType;
   UINT32 State = This->Mode->State;
@@ -1133,6 +1183,24 @@ Pp2SnpTransmit (
     ReturnUnlock(SavedTpl, EFI_NOT_READY);
   }
 
+  /*
+   * The caller has to recycle buffers through GetStatus, otherwise their
+   * completions could not be recorded.
+   */
+  if (Pp2Context->TxInFlightCount + QueueCount (Pp2Context) >= QUEUE_DEPTH - 1) {
+    ReturnUnlock(SavedTpl, EFI_NOT_READY);
+  }
+
+  /* Wait briefly for a slot if the TX ring is full */
+  PollingCount = 0;
+  Pp2DxeTxReap (Pp2Context, FALSE);
+  while (Pp2Context->TxInFlightCount >= Pp2Context->TxRingDepth) {
+    if (PollingCount++ > MVPP2_TX_SEND_MAX_POLLING_COUNT) {
+      ReturnUnlock(SavedTpl, EFI_NOT_READY);
+    }
+    Pp2DxeTxReap (Pp2Context, FALSE);
+  }
+
   /* Fetch next descriptor */
   TxDesc = Mvpp2TxqNextDescGet(AggrTxq);
 
@@ -1164,41 +1232,18 @@ Pp2SnpTransmit (
 
   InvalidateDataCacheRange (DataPtr, BufferSize);
 
-  /* Issue send */
-  Mvpp2AggrTxqPendDescAdd(Port, 1);
-
   /*
-   * Egress processing:
-   * Wait until packet is passed from per-cpu aggregated queue
-   * to physical per-port TXQ.
+   * Track the buffer before handing the descriptor to HW. Completions are
+   * reaped in batches from GetStatus, in the order frames were queued.
    */
-  PollingCount = 0;
-  TxSent = Mvpp2AggrTxqPendDescNumGet(Mvpp2Shared, 0);
-  do {
-    if (PollingCount++ > MVPP2_TX_SEND_MAX_POLLING_COUNT) {
-      DEBUG((DEBUG_ERROR, "Pp2Dxe: transmit polling failed\n"));
-      ReturnUnlock(SavedTpl, EFI_TIMEOUT);
-    }
-    TxSent = Mvpp2AggrTxqPendDescNumGet(Mvpp2Shared, 0);
-  } while (TxSent);
+  Slot = (Pp2Context->TxInFlightHead + Pp2Context->TxInFlightCount) % MVPP2_MAX_TXD;
+  Pp2Context->TxInFlight[Slot] = Buffer;
+  Pp2Context->TxInFlightCount++;
 
-  /* Wait for packet to be transmitted by hardware. */
-  PollingCount = 0;
-  TxSent = Mvpp2TxqSentDescProc(Port, &Port->Txqs[0]);
-  while (!TxSent) {
-    if (PollingCount++ > MVPP2_TX_SEND_MAX_POLLING_COUNT) {
-      DEBUG((DEBUG_ERROR, "Pp2Dxe: transmit polling failed\n"));
-      ReturnUnlock(SavedTpl, EFI_TIMEOUT);
-    }
-    TxSent = Mvpp2TxqSentDescProc(Port, &Port->Txqs[0]);
-  }
+  /* Issue send */
+  Mvpp2AggrTxqPendDescAdd(Port, 1);
 
-  /*
-   * At this point TxSent has increased - HW sent the packet
-   * Add buffer to completion queue and return.
-   */
-  Status = QueueInsert (Pp2Context, Buffer);
-  ReturnUnlock (SavedTpl, Status);
+  ReturnUnlock (SavedTpl, EFI_SUCCESS);
 }
 
 EFI_STATUS
@@ -1702,6 +1747,7 @@ Pp2DxeInitialiseController (
     }
 
     Pp2DxeParsePortPcd(Pp2Context, Index);
+    Pp2Context->TxRingDepth = MIN (MAX (PcdGet32 (PcdPp2TxRingDepth), 1), MVPP2_MAX_TXD);
     Pp2Context->Port.TxpNum = 1;
     Pp2Context->Port.Priv = Mvpp2Shared;
     Pp2Context->Port.FirstRxq = 4 * (PortIndex - 1);
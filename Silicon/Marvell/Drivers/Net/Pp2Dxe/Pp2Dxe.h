@@ -338,6 +338,11 @@ typedef struct {
   VOID                        *CompletionQueue[QUEUE_DEPTH];
   UINTN                       CompletionQueueHead;
   UINTN                       CompletionQueueTail;
+  /* Buffers handed to HW, in descriptor order, not yet reported as sent */
+  VOID                        *TxInFlight[MVPP2_MAX_TXD];
+  UINTN                       TxInFlightHead;
+  UINTN                       TxInFlightCount;
+  UINTN                       TxRingDepth;
   EFI_EVENT                   EfiExitBootServicesEvent;
   PP2_DEVICE_PATH             *DevicePath;
   EFI_ADAPTER_INFORMATION_PROTOCOL Aip;
@@ -119,6 +119,7 @@ DriverStart (
   EFI_MAC_ADDRESS                  *SwapMacAddressPtr;
   UINTN                            DescriptorSize;
   UINTN                            BufferSize;
+  UINTN                            TxBufferSize;
   UINTN                            *RxBufferAddr;
   EFI_PHYSICAL_ADDRESS             RxBufferAddrMap;
 
@@ -140,6 +141,14 @@ DriverStart (
   // Size for transmit and receive buffer
   BufferSize = ETH_BUFSIZE;
 
+  // DMA transmit buffer allocate, each descriptor owns one slot of it
+  Status = DmaAllocateBuffer (EfiBootServicesData,
+             EFI_SIZE_TO_PAGES (TX_TOTAL_BUFSIZE), (VOID **)&Snp->MacDriver.TxBuffer);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a () for TxBuffer: %r\n", __func__, Status));
+    return Status;
+  }
+
   for (int Index=0; Index < DESC_NUM; Index++) {
     //DMA TxdescRing allocate buffer and map
     Status = DmaAllocateBuffer (EfiBootServicesData,
@@ -180,6 +189,16 @@ DriverStart (
       return Status;
     }
     Snp->MacDriver.RxBufNum[Index].AddrMap= RxBufferAddrMap;
+
+    // DMA mapping for transmit buffer, kept for the lifetime of the driver
+    TxBufferSize = CONFIG_ETH_BUFSIZE;
+    Status = DmaMap (MapOperationBusMasterCommonBuffer,
+               &Snp->MacDriver.TxBuffer[Index * CONFIG_ETH_BUFSIZE],
+               &TxBufferSize, &Snp->MacDriver.TxBufNum[Index].AddrMap, &Snp->MacDriver.TxBufNum[Index].Mapping);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "%a () for Txbuffer: %r\n", __func__, Status));
+      return Status;
+    }
   }
 
   DevicePath = (SIMPLE_NETWORK_DEVICE_PATH*)AllocateCopyPool (sizeof (SIMPLE_NETWORK_DEVICE_PATH), &PathTemplate);
@@ -216,13 +235,10 @@ DriverStart (
   Snp->Snp.Transmit = SnpTransmit;
   Snp->Snp.Receive = SnpReceive;
 
-  Snp->RecycledTxBuf = AllocatePool (sizeof (UINT64) * SNP_TX_BUFFER_INCREASE);
-  if (Snp->RecycledTxBuf == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-  }
-
-  Snp->MaxRecycledTxBuf = SNP_TX_BUFFER_INCREASE;
+  Snp->RecycledTxBufHead = 0;
   Snp->RecycledTxBufCount = 0;
+  Snp->MacDriver.TxCurrentDescriptorNum = 0;
+  Snp->MacDriver.TxNextDescriptorNum = 0;
 
   // Start completing simple network mode structure
   SnpMode->State = EfiSimpleNetworkStopped;
@@ -253,8 +269,8 @@ DriverStart (
   // Mac address is changeable as it is loaded from erasable memory
   SnpMode->MacAddressChangeable = TRUE;
 
-  // Can only transmit one packet at a time
-  SnpMode->MultipleTxSupported = FALSE;
+  // Frames are queued on the transmit descriptor ring
+  SnpMode->MultipleTxSupported = TRUE;
 
   // MediaPresent checks for cable connection and partner link
   SnpMode->MediaPresentSupported = TRUE;
@@ -335,7 +351,11 @@ DriverStop (
     return Status;
   }
 
-  FreePool (Snp->RecycledTxBuf);
+  for (int Index=0; Index < DESC_NUM; Index++) {
+    DmaUnmap (Snp->MacDriver.TxBufNum[Index].Mapping);
+  }
+  DmaFreeBuffer (EFI_SIZE_TO_PAGES (TX_TOTAL_BUFSIZE), Snp->MacDriver.TxBuffer);
+
   FreePages (Snp, EFI_SIZE_TO_PAGES (sizeof (SIMPLE_NETWORK_DRIVER)));
 
   return Status;
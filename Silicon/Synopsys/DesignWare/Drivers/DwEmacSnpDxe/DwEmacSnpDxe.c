@@ -16,11 +16,18 @@
 #include "EmacDxeUtil.h"
 #include "PhyDxeUtil.h"
 
+#include <Library/BaseLib.h>
 #include <Library/DebugLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/NetLib.h>
 #include <Library/DmaLib.h>
 
+STATIC
+VOID
+SnpFlushTxDescriptors (
+  IN  SIMPLE_NETWORK_DRIVER   *Snp
+  );
+
 /**
   Change the state of a network interface from "stopped" to "started."
 
@@ -189,7 +196,9 @@ SnpInitialize (
     return EFI_DEVICE_ERROR;
   }
 
-  // Init EMAC
+  // Init EMAC. This resets the transmit ring, so first hand the buffers of
+  // frames still queued back through GetStatus instead of losing them.
+  SnpFlushTxDescriptors (Snp);
   Status = EmacDxeInitialization (&Snp->MacDriver, Snp->MacBase);
   if (EFI_ERROR (Status)) {
     return EFI_DEVICE_ERROR;
@@ -768,6 +777,106 @@ SnpNvData (
 }
 
 
+/**
+  Returns the number of frames queued in the transmit ring.
+
+  @param Snp             A pointer to the SIMPLE_NETWORK_DRIVER instance.
+
+  @return The number of queued transmit descriptors.
+
+**/
+STATIC
+UINT32
+SnpTxPendingCount (
+  IN  SIMPLE_NETWORK_DRIVER   *Snp
+  )
+{
+  return (Snp->MacDriver.TxNextDescriptorNum + CONFIG_TX_DESCR_NUM -
+          Snp->MacDriver.TxCurrentDescriptorNum) % CONFIG_TX_DESCR_NUM;
+}
+
+/**
+  Appends a caller buffer to the recycled transmit buffer queue.
+
+  @param Snp             A pointer to the SIMPLE_NETWORK_DRIVER instance.
+  @param TxBuf           The caller buffer of a frame that left the ring.
+
+**/
+STATIC
+VOID
+SnpRecycleTxBuf (
+  IN  SIMPLE_NETWORK_DRIVER   *Snp,
+  IN  UINT64                  TxBuf
+  )
+{
+  ASSERT (Snp->RecycledTxBufCount < CONFIG_TX_DESCR_NUM);
+
+  Snp->RecycledTxBuf[(Snp->RecycledTxBufHead + Snp->RecycledTxBufCount) % CONFIG_TX_DESCR_NUM] = TxBuf;
+  Snp->RecycledTxBufCount++;
+}
+
+/**
+  Reclaims the transmit descriptors the DMA engine has finished with.
+
+  Walks the ring from the oldest queued descriptor and stops at the first one
+  the hardware still owns, moving the caller buffer of every completed frame to
+  the recycled transmit buffer queue.
+
+  @param Snp             A pointer to the SIMPLE_NETWORK_DRIVER instance.
+
+**/
+STATIC
+VOID
+SnpReclaimTxDescriptors (
+  IN  SIMPLE_NETWORK_DRIVER   *Snp
+  )
+{
+  EMAC_DRIVER                *MacDriver;
+  DESIGNWARE_HW_DESCRIPTOR   *TxDescriptor;
+
+  MacDriver = &Snp->MacDriver;
+
+  while ((MacDriver->TxCurrentDescriptorNum != MacDriver->TxNextDescriptorNum) &&
+         (Snp->RecycledTxBufCount < CONFIG_TX_DESCR_NUM)) {
+    TxDescriptor = MacDriver->TxdescRing[MacDriver->TxCurrentDescriptorNum];
+    if ((TxDescriptor->Tdes0 & TDES0_OWN) != 0) {
+      break;
+    }
+
+    SnpRecycleTxBuf (Snp, Snp->TxPendingBuf[MacDriver->TxCurrentDescriptorNum]);
+
+    MacDriver->TxCurrentDescriptorNum =
+      (MacDriver->TxCurrentDescriptorNum + 1) % CONFIG_TX_DESCR_NUM;
+  }
+}
+
+/**
+  Empties the transmit ring before it is reset.
+
+  Moves the caller buffer of every queued frame, sent or not, to the recycled
+  transmit buffer queue in ring order, so that GetStatus still returns it.
+
+  @param Snp             A pointer to the SIMPLE_NETWORK_DRIVER instance.
+
+**/
+STATIC
+VOID
+SnpFlushTxDescriptors (
+  IN  SIMPLE_NETWORK_DRIVER   *Snp
+  )
+{
+  EMAC_DRIVER                *MacDriver;
+
+  MacDriver = &Snp->MacDriver;
+
+  while (MacDriver->TxCurrentDescriptorNum != MacDriver->TxNextDescriptorNum) {
+    SnpRecycleTxBuf (Snp, Snp->TxPendingBuf[MacDriver->TxCurrentDescriptorNum]);
+
+    MacDriver->TxCurrentDescriptorNum =
+      (MacDriver->TxCurrentDescriptorNum + 1) % CONFIG_TX_DESCR_NUM;
+  }
+}
+
 /**
   Reads the current interrupt status and recycled transmit buffer status from a
   network interface.
@@ -837,12 +946,15 @@ SnpGetStatus (
 
   // TxBuff
   if (TxBuff != NULL) {
-    // Get a recycled buf from Snp->RecycledTxBuf
+    SnpReclaimTxDescriptors (Snp);
+
+    // Get the oldest recycled buf from Snp->RecycledTxBuf
     if (Snp->RecycledTxBufCount == 0) {
       *TxBuff = NULL;
     } else {
+      *TxBuff = (VOID *)(UINTN) Snp->RecycledTxBuf[Snp->RecycledTxBufHead];
+      Snp->RecycledTxBufHead = (Snp->RecycledTxBufHead + 1) % CONFIG_TX_DESCR_NUM;
       Snp->RecycledTxBufCount--;
-      *TxBuff = (VOID *)(UINTN) Snp->RecycledTxBuf[Snp->RecycledTxBufCount];
     }
   }
 
@@ -923,40 +1035,21 @@ SnpTransmit (
   SIMPLE_NETWORK_DRIVER      *Snp;
   UINT32                     DescNum;
   DESIGNWARE_HW_DESCRIPTOR   *TxDescriptor;
-  DESIGNWARE_HW_DESCRIPTOR   *TxDescriptorMap;
   UINT8                      *EthernetPacket;
-  UINT64                     *Tmp;
-  EFI_STATUS                 Status;
-  UINTN                      BufferSizeBuf;
-  EFI_PHYSICAL_ADDRESS       TxBufferAddrMap;
 
-  BufferSizeBuf = ETH_BUFSIZE;
   EthernetPacket = Data;
 
-  Snp = INSTANCE_FROM_SNP_THIS (This);
-
-  if (EFI_ERROR (EfiAcquireLockOrFail (&Snp->Lock))) {
-    return EFI_ACCESS_DENIED;
-  }
-
-  if ((Snp->MaxRecycledTxBuf + SNP_TX_BUFFER_INCREASE) >= SNP_MAX_TX_BUFFER_NUM) {
-    return EFI_NOT_READY;
-  }
-
   // Check preliminaries
   if ((This == NULL) || (Data == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
+
+  Snp = INSTANCE_FROM_SNP_THIS (This);
+
   if (Snp->SnpMode.State != EfiSimpleNetworkInitialized) {
     return EFI_NOT_STARTED;
   }
 
-  Snp->MacDriver.TxCurrentDescriptorNum = Snp->MacDriver.TxNextDescriptorNum;
-  DescNum = Snp->MacDriver.TxCurrentDescriptorNum;
-
-  TxDescriptor = Snp->MacDriver.TxdescRing[DescNum];
-  TxDescriptorMap = (VOID *)(UINTN)Snp->MacDriver.TxdescRingMap[DescNum].AddrMap;
-
   // Ensure header is correct size if non-zero
   if (HdrSize) {
     if (HdrSize != Snp->SnpMode.MediaHeaderSize) {
@@ -973,6 +1066,38 @@ SnpTransmit (
     return EFI_BUFFER_TOO_SMALL;
   }
 
+  // The frame must fit in the descriptor's transmit buffer
+  if (BuffSize > CONFIG_ETH_BUFSIZE) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (HdrSize && (SrcAddr == NULL)) {
+    SrcAddr = &Snp->SnpMode.CurrentAddress;
+  }
+
+  if (EFI_ERROR (EfiAcquireLockOrFail (&Snp->Lock))) {
+    return EFI_ACCESS_DENIED;
+  }
+
+  // Keep one descriptor free so a full ring is distinct from an empty one
+  DescNum = Snp->MacDriver.TxNextDescriptorNum;
+  if (((DescNum + 1) % CONFIG_TX_DESCR_NUM) == Snp->MacDriver.TxCurrentDescriptorNum) {
+    SnpReclaimTxDescriptors (Snp);
+    if (((DescNum + 1) % CONFIG_TX_DESCR_NUM) == Snp->MacDriver.TxCurrentDescriptorNum) {
+      EfiReleaseLock (&Snp->Lock);
+      return EFI_NOT_READY;
+    }
+  }
+
+  // Every queued buffer must still fit in the recycled queue once it leaves
+  // the ring, so wait for the caller to collect recycled buffers first
+  if (SnpTxPendingCount (Snp) + Snp->RecycledTxBufCount >= CONFIG_TX_DESCR_NUM) {
+    EfiReleaseLock (&Snp->Lock);
+    return EFI_NOT_READY;
+  }
+
+  TxDescriptor = Snp->MacDriver.TxdescRing[DescNum];
+
   if (HdrSize) {
     EthernetPacket[0] = DstAddr->Addr[0];
     EthernetPacket[1] = DstAddr->Addr[1];
@@ -992,22 +1117,20 @@ SnpTransmit (
     EthernetPacket[12] = (*Protocol & 0xFF00) >> 8;
   }
 
-  CopyMem ((VOID *)(UINTN)TxDescriptor->Addr, EthernetPacket, BuffSize);
-
-  Status = DmaMap (MapOperationBusMasterRead, (VOID *)(UINTN)TxDescriptor->Addr,
-             &BufferSizeBuf, &TxBufferAddrMap, &Snp->MappingTxbuf);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "%a () for Txbuffer: %r\n", __func__, Status));
-    return Status;
-  }
-  TxDescriptorMap->Addr = TxBufferAddrMap;
+  // The descriptor buffers are common buffers mapped at driver start
+  CopyMem (&Snp->MacDriver.TxBuffer[DescNum * CONFIG_ETH_BUFSIZE], EthernetPacket, BuffSize);
 
   TxDescriptor->Tdes1 = (BuffSize << TDES1_SIZE1SHFT) &
                          TDES1_SIZE1MASK;
 
-  TxDescriptor->Tdes0 |= (TDES0_TXFIRST |
-                          TDES0_TXLAST |
-                          TDES0_OWN);
+  // Hand the descriptor over only once the rest of it is visible to the DMA
+  MemoryFence ();
+  TxDescriptor->Tdes0 = (TDES0_TXCHAIN |
+                         TDES0_TXFIRST |
+                         TDES0_TXLAST |
+                         TDES0_OWN);
+
+  Snp->TxPendingBuf[DescNum] = (UINT64)(UINTN)Data;
 
   // Increase descriptor number
   DescNum++;
@@ -1018,24 +1141,9 @@ SnpTransmit (
 
   Snp->MacDriver.TxNextDescriptorNum = DescNum;
 
-  if (Snp->RecycledTxBufCount < Snp->MaxRecycledTxBuf) {
-    Snp->RecycledTxBuf[Snp->RecycledTxBufCount] = (UINT64)(UINTN)Data;
-    Snp->RecycledTxBufCount ++;
-  } else {
-    Tmp = AllocatePool (sizeof (UINT64) * (Snp->MaxRecycledTxBuf + SNP_TX_BUFFER_INCREASE));
-    if (Tmp == NULL) {
-      return EFI_DEVICE_ERROR;
-    }
-    CopyMem (Tmp, Snp->RecycledTxBuf, sizeof (UINT64) * Snp->RecycledTxBufCount);
-    FreePool (Snp->RecycledTxBuf);
-    Snp->RecycledTxBuf = Tmp;
-    Snp->MaxRecycledTxBuf += SNP_TX_BUFFER_INCREASE;
-  }
-
   // Start the transmission
   EmacDmaStart (Snp->MacBase);
 
-  DmaUnmap (Snp->MappingTxbuf);
   EfiReleaseLock (&Snp->Lock);
   return EFI_SUCCESS;
 }
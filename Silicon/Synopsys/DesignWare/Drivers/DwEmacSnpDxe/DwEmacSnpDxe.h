@@ -57,18 +57,20 @@ typedef struct {
 
   UINTN                                  MacBase;
 
-  // Array of the recycled transmit buffer address
-  UINT64                                 *RecycledTxBuf;
+  // Caller buffer of the frame queued in each transmit descriptor
+  UINT64                                 TxPendingBuf[CONFIG_TX_DESCR_NUM];
 
-  // The maximum number of recycled buffer pointers in RecycledTxBuf
-  UINT32                                 MaxRecycledTxBuf;
+  // Queue of the recycled transmit buffer addresses, returned in completion
+  // order. Transmit never lets the queued and recycled buffers together
+  // exceed the ring size, so every queued buffer always fits in here.
+  UINT64                                 RecycledTxBuf[CONFIG_TX_DESCR_NUM];
+
+  // Index of the oldest recycled buffer pointer in RecycledTxBuf
+  UINT32                                 RecycledTxBufHead;
 
   // Current number of recycled buffer pointers in RecycledTxBuf
   UINT32                                 RecycledTxBufCount;
 
-  // For TX buffer DmaUnmap
-  VOID                                   *MappingTxbuf;
-
 } SIMPLE_NETWORK_DRIVER;
 
 extern EFI_COMPONENT_NAME_PROTOCOL       gSnpComponentName;
@@ -76,8 +78,6 @@ extern EFI_COMPONENT_NAME2_PROTOCOL      gSnpComponentName2;
 
 #define SNP_DRIVER_SIGNATURE             SIGNATURE_32('A', 'S', 'N', 'P')
 #define INSTANCE_FROM_SNP_THIS(a)        CR(a, SIMPLE_NETWORK_DRIVER, Snp, SNP_DRIVER_SIGNATURE)
-#define SNP_TX_BUFFER_INCREASE           32
-#define SNP_MAX_TX_BUFFER_NUM            65536
 #define DESC_NUM                         10
 #define ETH_BUFSIZE                      0x800
 /*---------------------------------------------------------------------------------------------------------------------
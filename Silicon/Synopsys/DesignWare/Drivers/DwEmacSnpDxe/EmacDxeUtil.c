@@ -231,8 +231,9 @@ EmacSetupTxdesc (
   DESIGNWARE_HW_DESCRIPTOR   *TxDescriptor;
 
   for (Index = 0; Index < CONFIG_TX_DESCR_NUM; Index++) {
-    TxDescriptor = (VOID *)(UINTN)EmacDriver->TxdescRingMap[Index].AddrMap;
-    TxDescriptor->Addr = (UINT32)(UINTN)&EmacDriver->TxBuffer[Index * CONFIG_ETH_BUFSIZE];
+    TxDescriptor = EmacDriver->TxdescRing[Index];
+    // Each descriptor keeps its own buffer, mapped once at driver start
+    TxDescriptor->Addr = (UINT32)EmacDriver->TxBufNum[Index].AddrMap;
     if (Index < 9) {
       TxDescriptor->AddrNext = (UINT32)(UINTN)EmacDriver->TxdescRingMap[Index + 1].AddrMap;
     }
@@ -248,7 +249,8 @@ EmacSetupTxdesc (
               DW_EMAC_DMAGRP_TRANSMIT_DESCRIPTOR_LIST_ADDRESS_OFST,
               (UINT32)(UINTN)EmacDriver->TxdescRingMap[0].AddrMap);
 
-  // Initialize the descriptor number
+  // Initialize the descriptor number. The caller has already moved the
+  // buffers of any frames still queued to its recycled buffer queue.
   EmacDriver->TxCurrentDescriptorNum = 0;
   EmacDriver->TxNextDescriptorNum = 0;
 
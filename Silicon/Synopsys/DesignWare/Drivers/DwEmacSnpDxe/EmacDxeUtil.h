@@ -244,13 +244,14 @@ typedef struct {
 typedef struct {
   DESIGNWARE_HW_DESCRIPTOR    *TxdescRing[CONFIG_TX_DESCR_NUM];
   DESIGNWARE_HW_DESCRIPTOR    *RxdescRing[CONFIG_RX_DESCR_NUM];
-  CHAR8                       TxBuffer[TX_TOTAL_BUFSIZE];
+  CHAR8                       *TxBuffer;
   CHAR8                       RxBuffer[RX_TOTAL_BUFSIZE];
   MAP_INFO                    TxdescRingMap[CONFIG_TX_DESCR_NUM ];
   MAP_INFO                    RxdescRingMap[CONFIG_RX_DESCR_NUM ];
+  MAP_INFO                    TxBufNum[CONFIG_TX_DESCR_NUM];
   MAP_INFO                    RxBufNum[CONFIG_TX_DESCR_NUM];
-  UINT32                      TxCurrentDescriptorNum;
-  UINT32                      TxNextDescriptorNum;
+  UINT32                      TxCurrentDescriptorNum;     // Oldest descriptor not yet reclaimed
+  UINT32                      TxNextDescriptorNum;        // Next descriptor to queue a frame in
   UINT32                      RxCurrentDescriptorNum;
   UINT32                      RxNextDescriptorNum;
 } EMAC_DRIVER;